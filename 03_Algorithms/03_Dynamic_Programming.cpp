@@ -284,47 +284,65 @@ bool canPartition(vector<int> &nums) {
 
 // ===== 12. PALINDROME PARTITIONING (MIN CUTS) =====
 // Minimum cuts to partition string into palindromes
+// dp[i] = min cuts for s[0..i). Instead of an n x n isPal table, a
+// palindromic tree (eertree) lists the palindromic suffixes of each prefix;
+// they form O(log n) runs with equal length differences, and each run is
+// taken in O(1) via series links - O(n log n) time, O(n) memory.
+// Full eertree + Manacher queries: 05_Advanced/02_String_Algorithms.cpp
 
 int minCut(string s) {
     int n = s.length();
-    vector<vector<bool>> isPal(n, vector<bool>(n, false));
-    vector<int> dp(n);
+    if(n == 0) return 0;
     
-    // Precompute palindromes
-    for(int i = 0; i < n; i++) {
-        isPal[i][i] = true;
-    }
+    // Node 0: imaginary root (len -1), node 1: empty palindrome
+    vector<int> len = {-1, 0}, link = {0, 0}, diff = {0, 0}, seriesLink = {0, 0};
+    vector<int> firstChild = {-1, -1}, sibling = {-1, -1};
+    vector<char> edge = {0, 0};
     
-    for(int i = 0; i < n - 1; i++) {
-        if(s[i] == s[i + 1]) {
-            isPal[i][i + 1] = true;
+    auto child = [&](int v, char c) {
+        for(int u = firstChild[v]; u != -1; u = sibling[u]) {
+            if(edge[u] == c) return u;
         }
-    }
+        return -1;
+    };
+    auto extendable = [&](int v, int i) {
+        while(i - 1 - len[v] < 0 || s[i - 1 - len[v]] != s[i]) v = link[v];
+        return v;
+    };
     
-    for(int len = 3; len <= n; len++) {
-        for(int i = 0; i <= n - len; i++) {
-            int j = i + len - 1;
-            if(s[i] == s[j] && isPal[i + 1][j - 1]) {
-                isPal[i][j] = true;
-            }
-        }
-    }
+    vector<int> dp(n + 1), series(n + 2);
+    dp[0] = -1;  // No cut before the first piece
+    int last = 1;
     
-    // DP for minimum cuts
     for(int i = 0; i < n; i++) {
-        if(isPal[0][i]) {
-            dp[i] = 0;
-        } else {
-            dp[i] = i;
-            for(int j = 1; j <= i; j++) {
-                if(isPal[j][i]) {
-                    dp[i] = min(dp[i], dp[j - 1] + 1);
-                }
+        // Add s[i] to the tree
+        int v = extendable(last, i);
+        int u = child(v, s[i]);
+        if(u == -1) {
+            u = len.size();
+            len.push_back(len[v] + 2);
+            link.push_back(len[u] == 1 ? 1 : child(extendable(link[v], i), s[i]));
+            diff.push_back(len[u] - len[link[u]]);
+            seriesLink.push_back(diff[u] == diff[link[u]] ? seriesLink[link[u]] : link[u]);
+            sibling.push_back(firstChild[v]);
+            firstChild.push_back(-1);
+            edge.push_back(s[i]);
+            firstChild[v] = u;
+        }
+        last = u;
+        
+        // DP over runs of palindromic suffixes
+        dp[i + 1] = INT_MAX;
+        for(int w = last; len[w] > 0; w = seriesLink[w]) {
+            series[w] = dp[i + 1 - (len[seriesLink[w]] + diff[w])];
+            if(diff[w] == diff[link[w]]) {
+                series[w] = min(series[w], series[link[w]]);
             }
+            dp[i + 1] = min(dp[i + 1], series[w] + 1);
         }
     }
     
-    return dp[n - 1];
+    return dp[n];
 }
 
 // ===== 13. MAXIMUM SUM SUBARRAY (KADANE'S VARIANT) =====
@@ -382,6 +400,9 @@ int main() {
     vector<int> values = {1, 4, 5, 7};
     cout << "Knapsack value: " << knapsack01(weights, values, 7) << endl;
     
+    // Palindrome partitioning
+    cout << "Min cuts for 'aabbc': " << minCut("aabbc") << endl;
+    
     return 0;
 }
 
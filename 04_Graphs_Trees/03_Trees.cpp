@@ -12,6 +12,16 @@
 #include <algorithm>
 #include <climits>
 #include <map>
+#include <fstream>
+#include <string>
+#include <random>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
 using namespace std;
 
 // ===== BINARY TREE NODE =====
@@ -209,27 +219,27 @@ TreeNode* lowestCommonAncestorBST(TreeNode *root, TreeNode *p, TreeNode *q) {
 // ===== DISTANCE IN TREE =====
 
 // Distance between two nodes
-int findDistance(TreeNode *root, int a, int b) {
-    // Find LCA
-    TreeNode* findNode(TreeNode* root, int val) {
-        if(!root) return nullptr;
-        if(root->val == val) return root;
-        TreeNode *left = findNode(root->left, val);
-        TreeNode *right = findNode(root->right, val);
-        return left ? left : right;
-    }
+TreeNode* findNode(TreeNode* root, int val) {
+    if(!root) return nullptr;
+    if(root->val == val) return root;
+    TreeNode *left = findNode(root->left, val);
+    TreeNode *right = findNode(root->right, val);
+    return left ? left : right;
+}
+
+int distanceFromRoot(TreeNode *root, int val) {
+    if(!root) return -1;
+    if(root->val == val) return 0;
     
-    int distanceFromRoot(TreeNode *root, int val) {
-        if(!root) return -1;
-        if(root->val == val) return 0;
-        
-        int left = distanceFromRoot(root->left, val);
-        int right = distanceFromRoot(root->right, val);
-        
-        if(left == -1 && right == -1) return -1;
-        return 1 + (left == -1 ? right : left);
-    }
+    int left = distanceFromRoot(root->left, val);
+    int right = distanceFromRoot(root->right, val);
     
+    if(left == -1 && right == -1) return -1;
+    return 1 + (left == -1 ? right : left);
+}
+
+int findDistance(TreeNode *root, int a, int b) {
+    // Find LCA
     TreeNode *lca = lowestCommonAncestor(root, 
                                          findNode(root, a),
                                          findNode(root, b));
@@ -382,6 +392,482 @@ vector<int> topView(TreeNode *root) {
     return result;
 }
 
+// ===== CENTROID DECOMPOSITION =====
+// For distance queries on big general trees (10^6 nodes) where listing
+// paths like allPaths() / findDistance() is far too slow.
+// Nodes are 0..n-1, tree given as n - 1 edges. Everything is iterative,
+// so long chains don't overflow the recursion stack.
+//
+// Build: O(n log n). Every node has O(log n) centroid ancestors.
+// For each centroid c we keep two sorted distance arrays:
+//   all[c] - dist(c, u) for u in c's component
+//   par[c] - dist(parent centroid of c, u) for the same u (to remove double counting)
+// Queries:
+//   countWithin(v, k)        - nodes u with dist(v, u) <= k       O(log^2 n)
+//   mark(v)                  - mark node v (online)               O(log^2 n)
+//   countMarkedWithin(v, k)  - marked u with dist(v, u) <= k      O(log^2 n)
+//   nearestMarked(v)         - min dist(v, u) over marked u       O(log n)
+//   countPairsWithin(k)      - pairs {u, w} with dist(u, w) <= k  O(n log n)
+
+struct CentroidDecomposition {
+    int n;
+    vector<int> adjStart, adj;          // CSR adjacency list
+    vector<int> cpar, clevel;           // Parent / depth in centroid tree
+    vector<vector<int>> distAtLevel;    // distAtLevel[l][v] = dist(v, level-l centroid of v)
+    vector<int> segStart, segLen;       // Slice of all / par / fenwick owned by centroid c
+    vector<int> all, par;               // Sorted distance arrays (flat)
+    vector<int> fenAll, fenPar;         // Marked counts over all / par positions
+    vector<int> best;                   // Nearest marked distance per centroid
+    vector<bool> marked;
+    
+    CentroidDecomposition(int n, const vector<pair<int, int>> &edges)
+        : n(n), adjStart(n + 1, 0), cpar(n, -1), clevel(n, 0),
+          segStart(n, 0), segLen(n, 0), best(n, INT_MAX), marked(n, false) {
+        for(auto &e : edges) {
+            adjStart[e.first + 1]++;
+            adjStart[e.second + 1]++;
+        }
+        for(int i = 0; i < n; i++) adjStart[i + 1] += adjStart[i];
+        adj.resize(adjStart[n]);
+        vector<int> fill(adjStart.begin(), adjStart.end() - 1);
+        for(auto &e : edges) {
+            adj[fill[e.first]++] = e.second;
+            adj[fill[e.second]++] = e.first;
+        }
+        build();
+    }
+    
+    void build() {
+        all.reserve((size_t)n * 2);
+        par.reserve((size_t)n * 2);
+        
+        vector<bool> removed(n, false);
+        vector<int> order, parent(n), sub(n), dist(n);
+        order.reserve(n);
+        
+        // Stack of {component root, parent centroid}
+        vector<pair<int, int>> work;
+        if(n > 0) work.push_back({0, -1});
+        
+        while(!work.empty()) {
+            int root = work.back().first;
+            int up = work.back().second;
+            work.pop_back();
+            
+            // BFS order of the component, then subtree sizes bottom-up
+            order.clear();
+            order.push_back(root);
+            parent[root] = -1;
+            for(size_t i = 0; i < order.size(); i++) {
+                int u = order[i];
+                for(int e = adjStart[u]; e < adjStart[u + 1]; e++) {
+                    int w = adj[e];
+                    if(w != parent[u] && !removed[w]) {
+                        parent[w] = u;
+                        order.push_back(w);
+                    }
+                }
+            }
+            int total = order.size();
+            for(int i = total - 1; i >= 0; i--) {
+                int u = order[i];
+                sub[u] = 1;
+                for(int e = adjStart[u]; e < adjStart[u + 1]; e++) {
+                    int w = adj[e];
+                    if(w != parent[u] && !removed[w]) sub[u] += sub[w];
+                }
+            }
+            
+            // Walk towards the heavy child until no child has > total / 2
+            int c = root;
+            while(true) {
+                int next = -1;
+                for(int e = adjStart[c]; e < adjStart[c + 1]; e++) {
+                    int w = adj[e];
+                    if(w != parent[c] && !removed[w] && sub[w] * 2 > total) {
+                        next = w;
+                        break;
+                    }
+                }
+                if(next == -1) break;
+                c = next;
+            }
+            
+            int level = (up == -1) ? 0 : clevel[up] + 1;
+            cpar[c] = up;
+            clevel[c] = level;
+            if((int)distAtLevel.size() <= level) {
+                distAtLevel.push_back(vector<int>(n, 0));
+            }
+            
+            // BFS from the centroid for distances inside the component
+            vector<int> &dl = distAtLevel[level];
+            order.clear();
+            order.push_back(c);
+            parent[c] = -1;
+            dl[c] = 0;
+            for(size_t i = 0; i < order.size(); i++) {
+                int u = order[i];
+                for(int e = adjStart[u]; e < adjStart[u + 1]; e++) {
+                    int w = adj[e];
+                    if(w != parent[u] && !removed[w]) {
+                        parent[w] = u;
+                        dl[w] = dl[u] + 1;
+                        order.push_back(w);
+                    }
+                }
+            }
+            
+            // BFS order is already sorted by distance from c
+            segStart[c] = all.size();
+            segLen[c] = total;
+            for(int u : order) all.push_back(dl[u]);
+            for(int u : order) par.push_back(up == -1 ? 0 : distAtLevel[level - 1][u]);
+            sort(par.begin() + segStart[c], par.end());
+            
+            removed[c] = true;
+            for(int e = adjStart[c]; e < adjStart[c + 1]; e++) {
+                if(!removed[adj[e]]) work.push_back({adj[e], c});
+            }
+        }
+        
+        fenAll.assign(all.size(), 0);
+        fenPar.assign(par.size(), 0);
+    }
+    
+    // Number of entries <= k in a sorted slice
+    int countLE(const vector<int> &arr, int c, int k) const {
+        if(k < 0) return 0;
+        auto first = arr.begin() + segStart[c];
+        return upper_bound(first, first + segLen[c], k) - first;
+    }
+    
+    // Fenwick tree living in fen[segStart[c] .. segStart[c] + segLen[c])
+    void fenAdd(vector<int> &fen, int c, int pos, int delta) {
+        for(int i = pos + 1; i <= segLen[c]; i += i & -i) {
+            fen[segStart[c] + i - 1] += delta;
+        }
+    }
+    
+    int fenSum(const vector<int> &fen, int c, int cnt) const {
+        int s = 0;
+        for(int i = cnt; i > 0; i -= i & -i) {
+            s += fen[segStart[c] + i - 1];
+        }
+        return s;
+    }
+    
+    int countWithin(int v, int k) const {
+        int result = 0;
+        for(int c = v, prev = -1; c != -1; prev = c, c = cpar[c]) {
+            int d = distAtLevel[clevel[c]][v];
+            result += countLE(all, c, k - d);
+            if(prev != -1) result -= countLE(par, prev, k - d);
+        }
+        return result;
+    }
+    
+    void mark(int v) {
+        if(marked[v]) return;
+        marked[v] = true;
+        for(int c = v; c != -1; c = cpar[c]) {
+            int d = distAtLevel[clevel[c]][v];
+            best[c] = min(best[c], d);
+            // Equal distances share the slot of their first occurrence
+            fenAdd(fenAll, c, countLE(all, c, d - 1), 1);
+            if(cpar[c] != -1) {
+                int dup = distAtLevel[clevel[c] - 1][v];
+                fenAdd(fenPar, c, countLE(par, c, dup - 1), 1);
+            }
+        }
+    }
+    
+    int countMarkedWithin(int v, int k) const {
+        int result = 0;
+        for(int c = v, prev = -1; c != -1; prev = c, c = cpar[c]) {
+            int d = distAtLevel[clevel[c]][v];
+            result += fenSum(fenAll, c, countLE(all, c, k - d));
+            if(prev != -1) result -= fenSum(fenPar, prev, countLE(par, prev, k - d));
+        }
+        return result;
+    }
+    
+    // -1 if nothing is marked yet
+    int nearestMarked(int v) const {
+        int result = INT_MAX;
+        for(int c = v; c != -1; c = cpar[c]) {
+            if(best[c] != INT_MAX) {
+                result = min(result, best[c] + distAtLevel[clevel[c]][v]);
+            }
+        }
+        return result == INT_MAX ? -1 : result;
+    }
+    
+    // Pairs i < j in a sorted slice with a[i] + a[j] <= k (two pointers)
+    long long pairsLE(const vector<int> &arr, int c, int k) const {
+        long long cnt = 0;
+        int lo = segStart[c], hi = segStart[c] + segLen[c] - 1;
+        while(lo < hi) {
+            if(arr[lo] + arr[hi] <= k) {
+                cnt += hi - lo;
+                lo++;
+            } else {
+                hi--;
+            }
+        }
+        return cnt;
+    }
+    
+    long long countPairsWithin(int k) const {
+        long long result = 0;
+        for(int c = 0; c < n; c++) {
+            result += pairsLE(all, c, k);
+            if(cpar[c] != -1) result -= pairsLE(par, c, k);
+        }
+        return result;
+    }
+};
+
+// Convert a binary tree into the 0-indexed edge list used above
+// (index = preorder position). Iterative to handle deep trees.
+vector<pair<int, int>> treeToEdges(TreeNode *root, vector<TreeNode*> &nodes) {
+    vector<pair<int, int>> edges;
+    nodes.clear();
+    if(!root) return edges;
+    
+    vector<pair<TreeNode*, int>> st = {{root, -1}};
+    while(!st.empty()) {
+        TreeNode *node = st.back().first;
+        int parentIdx = st.back().second;
+        st.pop_back();
+        
+        int idx = nodes.size();
+        nodes.push_back(node);
+        if(parentIdx != -1) edges.push_back({parentIdx, idx});
+        
+        if(node->right) st.push_back({node->right, idx});
+        if(node->left) st.push_back({node->left, idx});
+    }
+    
+    return edges;
+}
+
+// ===== TREE SERIALIZATION (MMAP, ZERO-COPY) =====
+// Large trees stored on disk are loaded by mapping the file and walking it
+// in place - no `new TreeNode` per node, no parsing. (POSIX mmap.)
+//
+// File layout (nodes numbered in preorder, so left child of i is i + 1):
+//   header   : magic "ZTRE", version, node count n, pad   (16 bytes)
+//   vals     : int32_t[n]   node values in preorder
+//   right    : int32_t[n]   preorder index of right child, -1 if none
+//   hasLeft  : uint64_t[(n + 63) / 64]   bit i set if node i has a left child
+// About 8 bytes + 1 bit per node, versus 24 bytes for a TreeNode.
+
+const uint32_t TREE_MAGIC = 0x4552545A;  // "ZTRE"
+const uint32_t TREE_VERSION = 1;
+
+struct TreeFileHeader {
+    uint32_t magic;
+    uint32_t version;
+    uint32_t n;
+    uint32_t reserved;  // Keeps the arrays below 8-byte aligned
+};
+
+// Write tree in the format above - O(n), iterative
+bool writeTree(TreeNode *root, const string &path) {
+    vector<int32_t> vals, right;
+    vector<uint64_t> hasLeft;
+    
+    // {node, index of parent whose right pointer should be patched}
+    vector<pair<TreeNode*, int>> st;
+    if(root) st.push_back({root, -1});
+    while(!st.empty()) {
+        TreeNode *node = st.back().first;
+        int patch = st.back().second;
+        st.pop_back();
+        
+        int idx = vals.size();
+        if(patch != -1) right[patch] = idx;
+        vals.push_back(node->val);
+        right.push_back(-1);
+        if(idx % 64 == 0) hasLeft.push_back(0);
+        if(node->left) hasLeft[idx / 64] |= 1ULL << (idx % 64);
+        
+        if(node->right) st.push_back({node->right, idx});
+        if(node->left) st.push_back({node->left, -1});
+    }
+    
+    ofstream out(path, ios::binary);
+    if(!out) return false;
+    
+    TreeFileHeader header = {TREE_MAGIC, TREE_VERSION, (uint32_t)vals.size(), 0};
+    out.write((const char*)&header, sizeof(header));
+    out.write((const char*)vals.data(), vals.size() * sizeof(int32_t));
+    out.write((const char*)right.data(), right.size() * sizeof(int32_t));
+    out.write((const char*)hasLeft.data(), hasLeft.size() * sizeof(uint64_t));
+    
+    return (bool)out;
+}
+
+// Read-only view over a mapped tree file. Nodes are addressed by index,
+// -1 means "no node".
+class MappedTree {
+    void *data = MAP_FAILED;
+    size_t bytes = 0;
+    uint32_t n = 0;
+    const int32_t *vals = nullptr;
+    const int32_t *rights = nullptr;
+    const uint64_t *hasLeft = nullptr;
+    
+    // O(n) check before trusting the file: the preorder walk over rights[]
+    // and hasLeft must visit 0, 1, ..., n - 1 in order. That keeps every
+    // index in range and gives each node exactly one parent, so traversals
+    // can't read out of bounds or loop. Padding bits must be clear.
+    bool validate() const {
+        if(n % 64 && hasLeft[n / 64] >> (n % 64)) return false;
+        if(n && hasLeftChild(n - 1)) return false;  // Its left child would be index n
+        
+        vector<int> st;
+        if(n) st.push_back(0);
+        int next = 0;
+        while(!st.empty()) {
+            int i = st.back();
+            st.pop_back();
+            if(i != next++) return false;
+            
+            int r = rights[i];
+            if(r != -1 && (r <= i || r >= (int)n)) return false;
+            if(r != -1) st.push_back(r);
+            if(hasLeftChild(i)) st.push_back(i + 1);
+        }
+        return next == (int)n;
+    }
+    
+public:
+    MappedTree() {}
+    MappedTree(const MappedTree&) = delete;
+    MappedTree& operator=(const MappedTree&) = delete;
+    ~MappedTree() { close(); }
+    
+    bool open(const string &path) {
+        close();
+        int fd = ::open(path.c_str(), O_RDONLY);
+        if(fd < 0) return false;
+        
+        struct stat st;
+        if(fstat(fd, &st) != 0 || st.st_size < (off_t)sizeof(TreeFileHeader)) {
+            ::close(fd);
+            return false;
+        }
+        bytes = st.st_size;
+        data = mmap(nullptr, bytes, PROT_READ, MAP_PRIVATE, fd, 0);
+        ::close(fd);  // Mapping stays valid after close
+        if(data == MAP_FAILED) return false;
+        
+        const TreeFileHeader *header = (const TreeFileHeader*)data;
+        size_t words = (header->n + 63) / 64;
+        size_t expected = sizeof(TreeFileHeader) + 2 * (size_t)header->n * sizeof(int32_t)
+                          + words * sizeof(uint64_t);
+        if(header->magic != TREE_MAGIC || header->version != TREE_VERSION ||
+           bytes < expected) {
+            close();
+            return false;
+        }
+        
+        n = header->n;
+        vals = (const int32_t*)((const char*)data + sizeof(TreeFileHeader));
+        rights = vals + n;
+        hasLeft = (const uint64_t*)(rights + n);
+        if(n > (uint32_t)INT_MAX || !validate()) {
+            close();
+            return false;
+        }
+        return true;
+    }
+    
+    void close() {
+        if(data != MAP_FAILED) munmap(data, bytes);
+        data = MAP_FAILED;
+        bytes = 0;
+        n = 0;
+    }
+    
+    int size() const { return n; }
+    int root() const { return n ? 0 : -1; }
+    int val(int i) const { return vals[i]; }
+    int right(int i) const { return rights[i]; }
+    int left(int i) const { return hasLeftChild(i) ? i + 1 : -1; }
+    
+    bool hasLeftChild(int i) const {
+        return (hasLeft[i / 64] >> (i % 64)) & 1;
+    }
+};
+
+// Inorder traversal directly on the mapped file
+vector<int> inorderMapped(const MappedTree &tree) {
+    vector<int> result;
+    vector<int> st;
+    int curr = tree.root();
+    
+    while(curr != -1 || !st.empty()) {
+        while(curr != -1) {
+            st.push_back(curr);
+            curr = tree.left(curr);
+        }
+        curr = st.back();
+        st.pop_back();
+        result.push_back(tree.val(curr));
+        curr = tree.right(curr);
+    }
+    
+    return result;
+}
+
+// Compare: rebuild with buildTreeFromInPre vs. write + mmap + traverse
+void benchmarkTreeLoad(int n, const string &path) {
+    // Random BST over distinct values (buildTreeFromInPre needs distinct keys)
+    mt19937 rng(12345);
+    vector<int> keys(n);
+    for(int i = 0; i < n; i++) keys[i] = i;
+    shuffle(keys.begin(), keys.end(), rng);
+    
+    TreeNode *root = nullptr;
+    for(int key : keys) {
+        TreeNode **slot = &root;
+        while(*slot) slot = key < (*slot)->val ? &(*slot)->left : &(*slot)->right;
+        *slot = new TreeNode(key);
+    }
+    
+    vector<int> pre, in;
+    preorder(root, pre);
+    inorder(root, in);
+    
+    auto start = chrono::steady_clock::now();
+    int preIdx = 0;
+    TreeNode *rebuilt = buildTreeFromInPre(pre, in, preIdx, 0, n - 1);
+    auto mid = chrono::steady_clock::now();
+    
+    writeTree(root, path);
+    auto written = chrono::steady_clock::now();
+    
+    MappedTree mapped;
+    mapped.open(path);
+    vector<int> mappedIn = inorderMapped(mapped);
+    auto end = chrono::steady_clock::now();
+    
+    auto ms = [](chrono::steady_clock::duration d) {
+        return chrono::duration<double, milli>(d).count();
+    };
+    cout << "n = " << n << endl;
+    cout << "  buildTreeFromInPre:  " << ms(mid - start) << " ms" << endl;
+    cout << "  writeTree:           " << ms(written - mid) << " ms" << endl;
+    cout << "  mmap + inorder walk: " << ms(end - written) << " ms"
+         << (mappedIn == in ? " (matches)" : " (MISMATCH)") << endl;
+    
+    (void)rebuilt;  // Trees are left to process exit, like the rest of this file
+    remove(path.c_str());
+}
+
 // ===== MAIN FUNCTION =====
 int main() {
     // Create sample tree
@@ -414,6 +900,27 @@ int main() {
         cout << endl;
     }
     
+    // Centroid decomposition on the same tree
+    vector<TreeNode*> nodes;
+    vector<pair<int, int>> edges = treeToEdges(root, nodes);
+    CentroidDecomposition cd(nodes.size(), edges);
+    cout << "Pairs at distance <= 2: " << cd.countPairsWithin(2) << endl;
+    cd.mark(2);  // node 4 (index = preorder position)
+    cout << "Nearest marked from node 6: " << cd.nearestMarked(5) << endl;
+    
+    // Serialize, map back and traverse without rebuilding
+    writeTree(root, "tree.bin");
+    MappedTree mapped;
+    if(mapped.open("tree.bin")) {
+        cout << "Mapped inorder: ";
+        for(int x : inorderMapped(mapped)) cout << x << " ";
+        cout << endl;
+    }
+    mapped.close();
+    remove("tree.bin");
+    
+    benchmarkTreeLoad(200000, "tree_bench.bin");
+    
     return 0;
 }
 
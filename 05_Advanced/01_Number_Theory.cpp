@@ -7,9 +7,21 @@
 
 #include <iostream>
 #include <vector>
+#include <string>
 #include <cmath>
 #include <algorithm>
 #include <bitset>
+#include <cstdint>
+#include <thread>
+#include <mutex>
+#include <atomic>
+#include <random>
+#include <chrono>
+#include <cassert>
+#include <utility>
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#endif
 using namespace std;
 
 // ===== 1. PRIME NUMBERS =====
@@ -20,7 +32,7 @@ bool isPrime(int n) {
     if(n == 2) return true;
     if(n % 2 == 0) return false;
     
-    for(int i = 3; i * i <= n; i += 2) {
+    for(int i = 3; i <= n / i; i += 2) {  // i * i would overflow near 2^31
         if(n % i == 0) return false;
     }
     
@@ -44,15 +56,190 @@ vector<bool> sieveOfEratosthenes(int n) {
     return isPrime;
 }
 
-// Get list of primes up to n
+// Segmented sieve with a 2*3*5 wheel - for limits far beyond 10^7
+// One byte covers 30 numbers: only residues coprime to 30 get a bit,
+// and we sieve one L1-sized block at a time.
+// Each 32KB segment costs O(segment + 8 * pi(sqrt(limit))), since every
+// sieving prime is visited once per segment even when it has no multiple
+// there - past ~10^11 that per-prime overhead dominates the runtime.
+// Multiples of a prime p that are coprime to 30 form 8 progressions,
+// each hitting the same bit every p bytes.
+
+const int WHEEL_RESIDUES[8] = {1, 7, 11, 13, 17, 19, 23, 29};
+const size_t SIEVE_SEGMENT_BYTES = 32 * 1024;  // ~1M numbers per L1-sized block
+
+int wheelBit(int residue) {
+    for(int b = 0; b < 8; b++) {
+        if(WHEEL_RESIDUES[b] == residue) return b;
+    }
+    return -1;
+}
+
+// Sieving primes 7..sqrt(limit), using the simple sieve above
+vector<uint32_t> wheelSievingPrimes(uint64_t limit) {
+    uint64_t root = sqrtl((long double)limit);
+    while(root * root > limit) root--;
+    while((root + 1) * (root + 1) <= limit) root++;
+    
+    vector<bool> small = sieveOfEratosthenes(root);
+    vector<uint32_t> primes;
+    for(uint64_t i = 7; i <= root; i++) {
+        if(small[i]) primes.push_back(i);
+    }
+    return primes;
+}
+
+struct WheelSieve {
+    uint64_t limit;
+    uint64_t lastByte;                  // Byte holding `limit`
+    const vector<uint32_t> &primes;
+    vector<uint64_t> next;              // Next byte to cross off, per (prime, residue)
+    vector<uint8_t> mask;               // Bit crossed off, per (prime, residue)
+    vector<uint8_t> seg;                // Current segment, bit set = prime
+    
+    // Cursor starts at byte `startByte` (segments must then be sieved in order)
+    WheelSieve(uint64_t limit, const vector<uint32_t> &primes, uint64_t startByte)
+        : limit(limit), lastByte(limit / 30), primes(primes),
+          next(primes.size() * 8), mask(primes.size() * 8) {
+        uint64_t low = startByte * 30;
+        for(size_t k = 0; k < primes.size(); k++) {
+            uint64_t p = primes[k];
+            uint64_t q0 = max(p, (low + p - 1) / p);  // Start at p*p or the block
+            for(int i = 0; i < 8; i++) {
+                uint64_t q = q0 + (WHEEL_RESIDUES[i] - q0 % 30 + 30) % 30;
+                uint64_t m = p * q;
+                next[k * 8 + i] = m / 30;
+                mask[k * 8 + i] = 1 << wheelBit(m % 30);
+            }
+        }
+    }
+    
+    // Sieve bytes [start, start + bytes); returns false if start is past limit
+    bool sieveSegment(uint64_t start, size_t bytes) {
+        if(start > lastByte) return false;
+        bytes = min<uint64_t>(bytes, lastByte - start + 1);
+        seg.assign(bytes, 0xFF);
+        
+        for(size_t k = 0; k < primes.size(); k++) {
+            size_t p = primes[k];
+            for(int i = 0; i < 8; i++) {
+                uint64_t j = next[k * 8 + i] - start;
+                uint8_t clear = ~mask[k * 8 + i];
+                for(; j < bytes; j += p) {
+                    seg[j] &= clear;
+                }
+                next[k * 8 + i] = start + j;
+            }
+        }
+        
+        if(start == 0) seg[0] &= ~1;  // 1 is not prime
+        
+        // Drop bits above limit in the final byte
+        if(start + bytes - 1 == lastByte) {
+            for(int b = 0; b < 8; b++) {
+                if(lastByte * 30 + WHEEL_RESIDUES[b] > limit) {
+                    seg[bytes - 1] &= ~(1 << b);
+                }
+            }
+        }
+        return true;
+    }
+};
+
+// Count primes <= n, sieving segments in parallel - about O(n log log n / threads)
+// (older toolchains may need -pthread)
+uint64_t countPrimes(uint64_t n, int threads = 0) {
+    if(n < 2) return 0;
+    uint64_t count = (n >= 2) + (n >= 3) + (n >= 5);
+    
+    vector<uint32_t> primes = wheelSievingPrimes(n);
+    uint64_t totalBytes = n / 30 + 1;
+    uint64_t segments = (totalBytes + SIEVE_SEGMENT_BYTES - 1) / SIEVE_SEGMENT_BYTES;
+    
+    if(threads <= 0) threads = max(1u, thread::hardware_concurrency());
+    threads = min<uint64_t>(threads, segments);
+    
+    vector<uint64_t> partial(threads, 0);
+    vector<thread> workers;
+    for(int t = 0; t < threads; t++) {
+        workers.emplace_back([&, t]() {
+            // Each thread owns a contiguous run of segments
+            uint64_t firstSeg = segments * t / threads;
+            uint64_t lastSeg = segments * (t + 1) / threads;
+            WheelSieve sieve(n, primes, firstSeg * SIEVE_SEGMENT_BYTES);
+            
+            for(uint64_t s = firstSeg; s < lastSeg; s++) {
+                if(!sieve.sieveSegment(s * SIEVE_SEGMENT_BYTES, SIEVE_SEGMENT_BYTES)) break;
+                uint64_t c = 0;
+                for(uint8_t byte : sieve.seg) c += __builtin_popcount(byte);
+                partial[t] += c;
+            }
+        });
+    }
+    for(auto &w : workers) w.join();
+    
+    for(uint64_t c : partial) count += c;
+    return count;
+}
+
+// Streaming prime iterator - primes come out in order, one segment in memory
+// Usage: PrimeIterator it(n); uint64_t p; while(it.next(p)) { ... }
+class PrimeIterator {
+    uint64_t limit;
+    vector<uint32_t> primes;
+    WheelSieve sieve;
+    uint64_t segStart = 0;
+    size_t byteIdx = 0;
+    uint8_t bits = 0;
+    int smallIdx = 0;       // Position in {2, 3, 5}
+    bool started = false;
+    
+public:
+    PrimeIterator(uint64_t limit)
+        : limit(limit), primes(wheelSievingPrimes(limit)),
+          sieve(limit, primes, 0) {}
+    
+    // sieve refers to our own primes, so a copy or move would dangle
+    PrimeIterator(const PrimeIterator&) = delete;
+    PrimeIterator& operator=(const PrimeIterator&) = delete;
+    
+    bool next(uint64_t &p) {
+        const int SMALL[3] = {2, 3, 5};
+        if(smallIdx < 3) {
+            p = SMALL[smallIdx++];
+            return p <= limit;
+        }
+        
+        while(bits == 0) {
+            if(!started || byteIdx + 1 >= sieve.seg.size()) {
+                uint64_t start = started ? segStart + sieve.seg.size() : 0;
+                if(!sieve.sieveSegment(start, SIEVE_SEGMENT_BYTES)) return false;
+                segStart = start;
+                byteIdx = 0;
+                started = true;
+            } else {
+                byteIdx++;
+            }
+            bits = sieve.seg[byteIdx];
+        }
+        
+        int b = __builtin_ctz(bits);
+        bits &= bits - 1;
+        p = (segStart + byteIdx) * 30 + WHEEL_RESIDUES[b];
+        return true;
+    }
+};
+
+// Get list of primes up to n (streams through the segmented sieve,
+// so no n + 1 sized table is allocated)
 vector<int> getPrimes(int n) {
-    vector<bool> sieve = sieveOfEratosthenes(n);
     vector<int> primes;
+    if(n >= 2) primes.reserve(n / max(1.0, log((double)n) - 1.1));
     
-    for(int i = 2; i <= n; i++) {
-        if(sieve[i]) {
-            primes.push_back(i);
-        }
+    PrimeIterator it(max(n, 0));
+    uint64_t p;
+    while(it.next(p)) {
+        primes.push_back(p);
     }
     
     return primes;
@@ -150,35 +337,302 @@ int extendedGcd(int a, int b, int &x, int &y) {
     return g;
 }
 
+// Iterative 64-bit version (no recursion, no int overflow)
+long long extendedGcd64(long long a, long long b, long long &x, long long &y) {
+    long long x0 = 1, y0 = 0, x1 = 0, y1 = 1;
+    while(b != 0) {
+        long long q = a / b;
+        long long t = a - q * b; a = b; b = t;
+        t = x0 - q * x1; x0 = x1; x1 = t;
+        t = y0 - q * y1; y0 = y1; y1 = t;
+    }
+    x = x0;
+    y = y0;
+    return a;
+}
+
+// Inverse of a mod m for any m (not just primes); -1 if gcd(a, m) != 1
+long long modInverseGeneral(long long a, long long m) {
+    long long x, y;
+    a %= m;
+    if(a < 0) a += m;
+    if(extendedGcd64(a, m, x, y) != 1) return -1;
+    x %= m;
+    return x < 0 ? x + m : x;
+}
+
 // ===== 3. MODULAR ARITHMETIC =====
 
 const int MOD = 1000000007;  // Common mod in CP
 
+typedef unsigned __int128 u128;
+
+// ModInt<M>: value type for arithmetic mod a compile-time odd M < 2^31.
+// Stored in Montgomery form (x * 2^32 mod M) so multiplication is two
+// integer multiplies and a shift - no division. Conversion happens only
+// when a value is created or read back with val().
+// Usage: typedef ModInt<MOD> mint; mint a = 5; a = a.pow(10) / 3;
+
+template<uint32_t M>
+struct ModInt {
+    static_assert(M % 2 == 1 && M < (1u << 31), "Montgomery needs an odd modulus < 2^31");
+    
+    static constexpr uint32_t computeNegInv() {
+        uint32_t inv = M;
+        for(int i = 0; i < 4; i++) inv *= 2 - M * inv;  // Newton: M^-1 mod 2^32
+        return -inv;
+    }
+    static constexpr uint32_t NEG_INV = computeNegInv();         // -M^-1 mod 2^32
+    static constexpr uint32_t R2 = (uint32_t)(-(uint64_t)M % M);  // 2^64 mod M
+    
+    // x * 2^-32 mod M, for x < M * 2^32
+    static uint32_t reduce(uint64_t x) {
+        uint32_t q = (uint32_t)x * NEG_INV;
+        uint32_t r = (x + (uint64_t)q * M) >> 32;
+        return r >= M ? r - M : r;
+    }
+    
+    uint32_t v;  // Montgomery form
+    
+    ModInt() : v(0) {}
+    ModInt(long long x) {
+        x %= (long long)M;  // Constant modulus: compiled to a multiply, not a divide
+        if(x < 0) x += M;
+        v = reduce((uint64_t)x * R2);
+    }
+    
+    static constexpr uint32_t mod() { return M; }
+    static ModInt raw(uint32_t montgomery) { ModInt r; r.v = montgomery; return r; }
+    uint32_t val() const { return reduce(v); }
+    
+    ModInt& operator+=(const ModInt &o) { v += o.v; if(v >= M) v -= M; return *this; }
+    ModInt& operator-=(const ModInt &o) { v = v >= o.v ? v - o.v : v + M - o.v; return *this; }
+    ModInt& operator*=(const ModInt &o) { v = reduce((uint64_t)v * o.v); return *this; }
+    ModInt& operator/=(const ModInt &o) { return *this *= o.inv(); }
+    
+    friend ModInt operator+(ModInt a, const ModInt &b) { return a += b; }
+    friend ModInt operator-(ModInt a, const ModInt &b) { return a -= b; }
+    friend ModInt operator*(ModInt a, const ModInt &b) { return a *= b; }
+    friend ModInt operator/(ModInt a, const ModInt &b) { return a /= b; }
+    ModInt operator-() const { return ModInt() - *this; }
+    bool operator==(const ModInt &o) const { return v == o.v; }
+    bool operator!=(const ModInt &o) const { return v != o.v; }
+    
+    ModInt pow(long long exp) const {
+        ModInt result = 1, base = *this;
+        while(exp > 0) {
+            if(exp & 1) result *= base;
+            base *= base;
+            exp >>= 1;
+        }
+        return result;
+    }
+    
+    ModInt inv() const { return pow(M - 2); }  // M must be prime
+};
+
+// Barrett reduction for a modulus only known at runtime (2 <= m < 2^32).
+// im = ceil(2^64 / m); the quotient estimate is off by at most one,
+// so reduce() is exact for every z < 2^64.
+struct Barrett {
+    uint32_t m;
+    uint64_t im;
+    
+    Barrett(uint32_t m) : m(m), im((uint64_t)-1 / m + 1) {}
+    
+    uint32_t reduce(uint64_t z) const {
+        uint64_t x = ((u128)z * im) >> 64;
+        uint64_t v = z - x * m;
+        return m <= v ? v + m : v;  // Wrapped below zero: estimate was one too big
+    }
+    
+    uint32_t mul(uint32_t a, uint32_t b) const { return reduce((uint64_t)a * b); }
+};
+
+// Runtime-modulus counterpart of ModInt. All DynamicModInt<ID> share one
+// modulus set with setMod(); use different IDs for different moduli.
+template<int ID = 0>
+struct DynamicModInt {
+    static Barrett& barrett() {
+        static Barrett b(MOD);
+        return b;
+    }
+    static void setMod(uint32_t m) {
+        assert(m >= 2 && "Barrett needs a modulus of at least 2");
+        if(barrett().m != m) barrett() = Barrett(m);
+    }
+    static uint32_t mod() { return barrett().m; }
+    
+    uint32_t v;
+    
+    DynamicModInt() : v(0) {}
+    DynamicModInt(long long x) {
+        uint32_t r = barrett().reduce(x < 0 ? 0 - (uint64_t)x : (uint64_t)x);
+        v = (x < 0 && r != 0) ? mod() - r : r;
+    }
+    
+    uint32_t val() const { return v; }
+    
+    DynamicModInt& operator+=(const DynamicModInt &o) {
+        uint64_t s = (uint64_t)v + o.v;
+        v = s >= mod() ? s - mod() : s;
+        return *this;
+    }
+    DynamicModInt& operator-=(const DynamicModInt &o) { v = v >= o.v ? v - o.v : v + mod() - o.v; return *this; }
+    DynamicModInt& operator*=(const DynamicModInt &o) { v = barrett().mul(v, o.v); return *this; }
+    DynamicModInt& operator/=(const DynamicModInt &o) { return *this *= o.inv(); }
+    
+    friend DynamicModInt operator+(DynamicModInt a, const DynamicModInt &b) { return a += b; }
+    friend DynamicModInt operator-(DynamicModInt a, const DynamicModInt &b) { return a -= b; }
+    friend DynamicModInt operator*(DynamicModInt a, const DynamicModInt &b) { return a *= b; }
+    friend DynamicModInt operator/(DynamicModInt a, const DynamicModInt &b) { return a /= b; }
+    bool operator==(const DynamicModInt &o) const { return v == o.v; }
+    bool operator!=(const DynamicModInt &o) const { return v != o.v; }
+    
+    DynamicModInt pow(long long exp) const {
+        DynamicModInt result = 1, base = *this;
+        while(exp > 0) {
+            if(exp & 1) result *= base;
+            base *= base;
+            exp >>= 1;
+        }
+        return result;
+    }
+    
+    DynamicModInt inv() const { return pow(mod() - 2); }  // Prime modulus
+};
+
+// Batch multiply: out[i] = a[i] * b[i] for arrays of ModInt<M>.
+// On x86 with AVX2 (checked at runtime) 8 Montgomery products per step.
+#if defined(__x86_64__) || defined(__i386__)
+// 8 lanes of Montgomery a * b * 2^-32 mod m, inputs and output in [0, m)
+__attribute__((target("avx2")))
+inline __m256i montMulAVX2(__m256i a, __m256i b, __m256i m, __m256i negInv) {
+    // _mm256_mul_epu32 multiplies the even 32-bit lanes, so odd lanes go separately
+    __m256i prodEven = _mm256_mul_epu32(a, b);
+    __m256i prodOdd = _mm256_mul_epu32(_mm256_srli_epi64(a, 32), _mm256_srli_epi64(b, 32));
+    __m256i qEven = _mm256_mul_epu32(prodEven, negInv);
+    __m256i qOdd = _mm256_mul_epu32(prodOdd, negInv);
+    __m256i sumEven = _mm256_add_epi64(prodEven, _mm256_mul_epu32(qEven, m));
+    __m256i sumOdd = _mm256_add_epi64(prodOdd, _mm256_mul_epu32(qOdd, m));
+    // High halves hold the results: even lanes shift down, odd lanes already in place
+    __m256i r = _mm256_blend_epi32(_mm256_srli_epi64(sumEven, 32), sumOdd, 0xAA);
+    return _mm256_min_epu32(r, _mm256_sub_epi32(r, m));  // r < 2m -> [0, m)
+}
+
+__attribute__((target("avx2")))
+size_t batchMulAVX2(const uint32_t *a, const uint32_t *b, uint32_t *out, size_t n,
+                    uint32_t mod, uint32_t negInv) {
+    __m256i m = _mm256_set1_epi32(mod), ni = _mm256_set1_epi32(negInv);
+    size_t i = 0;
+    for(; i + 8 <= n; i += 8) {
+        __m256i x = _mm256_loadu_si256((const __m256i*)(a + i));
+        __m256i y = _mm256_loadu_si256((const __m256i*)(b + i));
+        _mm256_storeu_si256((__m256i*)(out + i), montMulAVX2(x, y, m, ni));
+    }
+    return i;
+}
+
+bool cpuHasAVX2() {
+    static const bool has = __builtin_cpu_supports("avx2");
+    return has;
+}
+#endif
+
+template<uint32_t M>
+void batchMul(const ModInt<M> *a, const ModInt<M> *b, ModInt<M> *out, size_t n) {
+    size_t i = 0;
+#if defined(__x86_64__) || defined(__i386__)
+    if(cpuHasAVX2()) {
+        // ModInt<M> is a single uint32_t, so the arrays can be read as raw lanes
+        i = batchMulAVX2((const uint32_t*)a, (const uint32_t*)b, (uint32_t*)out, n,
+                         M, ModInt<M>::NEG_INV);
+    }
+#endif
+    for(; i < n; i++) {
+        out[i] = a[i] * b[i];
+    }
+}
+
+// Helpers below take any int and a runtime modulus (< 2^31). For the
+// default modulus they use plain arithmetic with a compile-time constant
+// (the compiler turns % MOD into a multiply), otherwise a cached Barrett
+// reducer, so no call does a hardware divide.
+// Returned by value: a reference would change under the caller if a
+// nested call switched the cached modulus.
+Barrett barrettFor(uint32_t mod) {
+    thread_local Barrett cached(MOD);
+    if(cached.m != mod) cached = Barrett(mod);
+    return cached;
+}
+
+// Reduce any long long into [0, mod)
+uint32_t modNormalize(long long x, uint32_t mod) {
+    if(mod == 1) return 0;  // Barrett needs m >= 2
+    Barrett bt = barrettFor(mod);
+    uint32_t r = bt.reduce(x < 0 ? 0 - (uint64_t)x : (uint64_t)x);
+    return (x < 0 && r != 0) ? mod - r : r;
+}
+
 // Modular addition
 int modAdd(int a, int b, int mod = MOD) {
-    return ((long long)a + b) % mod;
+    if(mod == MOD) {
+        if((unsigned)a < MOD && (unsigned)b < MOD) {
+            int r = a + b;  // < 2 * MOD < 2^31
+            return r >= MOD ? r - MOD : r;
+        }
+        int r = ((long long)a + b) % MOD;
+        return r < 0 ? r + MOD : r;
+    }
+    return modNormalize((long long)a + b, mod);
 }
 
 // Modular subtraction
 int modSub(int a, int b, int mod = MOD) {
-    return ((a - b) % mod + mod) % mod;
+    if(mod == MOD) {
+        if((unsigned)a < MOD && (unsigned)b < MOD) {
+            int r = a - b;
+            return r < 0 ? r + MOD : r;
+        }
+        int r = ((long long)a - b) % MOD;
+        return r < 0 ? r + MOD : r;
+    }
+    return modNormalize((long long)a - b, mod);
 }
 
 // Modular multiplication
 int modMul(int a, int b, int mod = MOD) {
-    return ((long long)a * b) % mod;
+    if(mod == MOD) {
+        int r = (long long)a * b % MOD;
+        return r < 0 ? r + MOD : r;
+    }
+    if(mod == 1) return 0;
+    return barrettFor(mod).mul(modNormalize(a, mod), modNormalize(b, mod));
 }
 
 // Modular exponentiation - O(log n)
 long long modPow(long long base, long long exp, long long mod = MOD) {
+    if(mod == MOD) return ModInt<MOD>(base).pow(exp).val();
+    if(mod == 1) return 0;
+    
+    if(mod < (1LL << 32)) {
+        Barrett bt = barrettFor(mod);
+        uint32_t result = 1, b = modNormalize(base, mod);
+        while(exp > 0) {
+            if(exp & 1) result = bt.mul(result, b);
+            b = bt.mul(b, b);
+            exp >>= 1;
+        }
+        return result;
+    }
+    
+    // Wide moduli: 128-bit products
     long long result = 1;
     base %= mod;
-    
+    if(base < 0) base += mod;
     while(exp > 0) {
-        if(exp & 1) {
-            result = (result * base) % mod;
-        }
-        base = (base * base) % mod;
+        if(exp & 1) result = (u128)result * base % mod;
+        base = (u128)base * base % mod;
         exp >>= 1;
     }
     
@@ -195,6 +649,43 @@ long long modDiv(long long a, long long b, long long mod = MOD) {
     return (a * modInverse(b, mod)) % mod;
 }
 
+// Elementwise products of n values: hardware % vs ModInt vs DynamicModInt vs batchMul
+void benchmarkModArithmetic(int n) {
+    mt19937 rng(7);
+    vector<uint32_t> x(n), y(n), plain(n);
+    for(int i = 0; i < n; i++) {
+        x[i] = rng() % MOD;
+        y[i] = rng() % MOD;
+    }
+    volatile long long runtimeMod = MOD;  // Keeps the compiler from folding %
+    long long m = runtimeMod;
+    
+    typedef ModInt<MOD> mint;
+    vector<mint> mx(x.begin(), x.end()), my(y.begin(), y.end()), mout(n);
+    DynamicModInt<>::setMod(MOD);
+    vector<DynamicModInt<>> dx(x.begin(), x.end()), dy(y.begin(), y.end()), dout(n);
+    
+    auto time = [](auto &&body) {
+        auto start = chrono::steady_clock::now();
+        for(int rep = 0; rep < 10; rep++) body();
+        return chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+    };
+    
+    double tPlain = time([&]() { for(int i = 0; i < n; i++) plain[i] = (uint64_t)x[i] * y[i] % m; });
+    double tMont = time([&]() { for(int i = 0; i < n; i++) mout[i] = mx[i] * my[i]; });
+    double tBarrett = time([&]() { for(int i = 0; i < n; i++) dout[i] = dx[i] * dy[i]; });
+    double tBatch = time([&]() { batchMul(mx.data(), my.data(), mout.data(), n); });
+    
+    bool same = true;
+    for(int i = 0; i < n; i++) {
+        same &= mout[i].val() == plain[i] && dout[i].val() == plain[i];
+    }
+    
+    cout << "10 x " << n << " mulmods: % " << tPlain << " ms, ModInt " << tMont
+         << " ms, DynamicModInt " << tBarrett << " ms, batchMul " << tBatch << " ms"
+         << (same ? "" : " (MISMATCH)") << endl;
+}
+
 // ===== 4. FACTORIAL AND COMBINATIONS =====
 
 // Factorial
@@ -254,9 +745,179 @@ long long nPr(int n, int r, long long mod = MOD) {
     return result;
 }
 
+// Combinatorics table - O(n) setup, then O(1) nCr / nPr / catalan.
+// fact, inverse fact (one inversion of fact[n] + a backward pass) and
+// inverses of 1..n (inv[i] = -(M / i) * inv[M % i]). Needs n < M.
+// Non-const calls grow the table on demand (doubling). A const reference
+// never writes, so one prebuilt table can be shared across threads as long
+// as queries stay within limit().
+template<uint32_t M = MOD>
+struct Combinatorics {
+    typedef ModInt<M> mint;
+    vector<mint> fact, invFact, inv;
+    
+    explicit Combinatorics(int n = 1) : fact(1, 1), invFact(1, 1), inv(1, 0) {
+        grow(n);
+    }
+    
+    int limit() const { return fact.size() - 1; }
+    
+    void grow(int n) {
+        int old = limit();
+        if(n <= old) return;
+        n = max(n, 2 * old);
+        
+        fact.resize(n + 1);
+        invFact.resize(n + 1);
+        inv.resize(n + 1);
+        for(int i = old + 1; i <= n; i++) {
+            fact[i] = fact[i - 1] * mint(i);
+            inv[i] = (i == 1) ? mint(1) : -mint(M / i) * inv[M % i];
+        }
+        
+        invFact[n] = fact[n].inv();
+        for(int i = n; i > old + 1; i--) {
+            invFact[i - 1] = invFact[i] * mint(i);
+        }
+    }
+    
+    // Const queries: n must be <= limit()
+    mint nCr(int n, int r) const {
+        if(r < 0 || r > n) return 0;
+        assert(n <= limit());
+        return fact[n] * invFact[r] * invFact[n - r];
+    }
+    
+    mint nPr(int n, int r) const {
+        if(r < 0 || r > n) return 0;
+        assert(n <= limit());
+        return fact[n] * invFact[n - r];
+    }
+    
+    mint catalan(int n) const {
+        assert(max(2 * n, n + 1) <= limit());  // Reads invFact[n + 1], even for n = 0
+        return fact[2 * n] * invFact[n] * invFact[n + 1];
+    }
+    
+    // Growing queries
+    mint nCr(int n, int r) { grow(n); return as_const(*this).nCr(n, r); }
+    mint nPr(int n, int r) { grow(n); return as_const(*this).nPr(n, r); }
+    mint catalan(int n) { grow(max(2 * n, n + 1)); return as_const(*this).catalan(n); }
+};
+
 // ===== 5. CHINESE REMAINDER THEOREM =====
 // Solve system: x ≡ a1 (mod m1), x ≡ a2 (mod m2), ...
 
+// Merge x ≡ r1 (mod m1) with x ≡ r2 (mod m2); moduli need not be coprime.
+// On success r1, m1 become the combined residue and lcm(m1, m2).
+// Returns false if the system has no solution or the lcm exceeds 2^62.
+// Products go through __int128, so nothing overflows on the way.
+bool crtMerge(long long &r1, long long &m1, long long r2, long long m2) {
+    long long p, q;
+    long long g = extendedGcd64(m1, m2, p, q);  // p * m1 + q * m2 = g
+    if((r2 - r1) % g != 0) return false;
+    
+    long long step = m2 / g;
+    if((__int128)m1 * step > (1LL << 62)) return false;
+    
+    // x = r1 + m1 * t with t = (r2 - r1) / g * p (mod m2 / g)
+    long long t = (__int128)((r2 - r1) / g) * p % step;
+    if(t < 0) t += step;
+    long long lcmValue = m1 * step;
+    long long x = (r1 + (__int128)m1 * t) % lcmValue;
+    
+    r1 = x < 0 ? x + lcmValue : x;
+    m1 = lcmValue;
+    return true;
+}
+
+// Whole system - O(k log M). Returns {x, lcm} or {-1, -1} if unsolvable.
+pair<long long, long long> chineseRemainder(const vector<long long> &residues,
+                                            const vector<long long> &moduli) {
+    long long r = 0, m = 1;
+    for(size_t i = 0; i < residues.size(); i++) {
+        long long ri = residues[i] % moduli[i];
+        if(ri < 0) ri += moduli[i];
+        if(!crtMerge(r, m, ri, moduli[i])) return {-1, -1};
+    }
+    return {r, m};
+}
+
+// Garner's algorithm for many residue tuples over one fixed set of pairwise
+// coprime moduli (e.g. multi-modulus hashes). Setup is O(k^2); each
+// reconstruction is O(k^2) mulmods with no gcds or inversions.
+// x = c[0] + c[1] m[0] + c[2] m[0] m[1] + ..., with 0 <= c[i] < m[i].
+struct GarnerCRT {
+    vector<uint64_t> m;
+    vector<uint64_t> invPrefix;          // (m[0] ... m[i-1])^-1 mod m[i]
+    vector<vector<uint64_t>> prefixMod;  // prefixMod[i][j] = m[0] ... m[j-1] mod m[i]
+    
+    GarnerCRT() {}
+    GarnerCRT(const vector<uint64_t> &moduli) : m(moduli) {
+        int k = m.size();
+        prefixMod.assign(k, vector<uint64_t>());
+        invPrefix.resize(k);
+        for(int i = 0; i < k; i++) {
+            prefixMod[i].resize(i + 1);
+            prefixMod[i][0] = 1 % m[i];
+            for(int j = 1; j <= i; j++) {
+                prefixMod[i][j] = (u128)prefixMod[i][j - 1] * (m[j - 1] % m[i]) % m[i];
+            }
+            invPrefix[i] = modInverseGeneral(prefixMod[i][i], m[i]);
+        }
+    }
+    
+    // Mixed-radix digits c[i] of the unique x < m[0] * ... * m[k-1]
+    vector<uint64_t> digits(const uint64_t *residues) const {
+        int k = m.size();
+        vector<uint64_t> c(k);
+        for(int i = 0; i < k; i++) {
+            // Value of c[0..i-1] mod m[i]
+            uint64_t partial = 0;
+            for(int j = 0; j < i; j++) {
+                partial = (partial + (u128)c[j] * prefixMod[i][j]) % m[i];
+            }
+            uint64_t r = residues[i] % m[i];
+            uint64_t diff = r >= partial ? r - partial : r + m[i] - partial;
+            c[i] = (u128)diff * invPrefix[i] % m[i];
+        }
+        return c;
+    }
+    
+    // x mod target
+    uint64_t reconstruct(const uint64_t *residues, uint64_t target) const {
+        vector<uint64_t> c = digits(residues);
+        uint64_t result = 0, place = 1 % target;
+        for(size_t i = 0; i < c.size(); i++) {
+            result = (result + (u128)(c[i] % target) * place) % target;
+            place = (u128)place * (m[i] % target) % target;
+        }
+        return result;
+    }
+    
+    // x itself, when the product of the moduli fits in 128 bits
+    u128 reconstruct128(const uint64_t *residues) const {
+        vector<uint64_t> c = digits(residues);
+        u128 result = 0, place = 1;
+        for(size_t i = 0; i < c.size(); i++) {
+            result += place * c[i];
+            place *= m[i];
+        }
+        return result;
+    }
+    
+    // Batch: residues[i][t] = value t mod m[i]; returns every value mod target
+    vector<uint64_t> reconstructAll(const vector<vector<uint64_t>> &residues, uint64_t target) const {
+        size_t n = residues.empty() ? 0 : residues[0].size();
+        vector<uint64_t> result(n), tuple(m.size());
+        for(size_t t = 0; t < n; t++) {
+            for(size_t i = 0; i < m.size(); i++) tuple[i] = residues[i][t];
+            result[t] = reconstruct(tuple.data(), target);
+        }
+        return result;
+    }
+};
+
 // ===== 6. EULER'S TOTIENT FUNCTION =====
 // Count numbers <= n coprime with n
 
@@ -302,14 +963,138 @@ vector<int> eulerTotientSieve(int n) {
 
 // ===== 8. LUCAS THEOREM =====
 // For computing nCr mod p where p is prime
+// Every base-p digit is below min(p, n + 1), so one factorial table of that
+// size serves all digits. It is cached per thread and reused while p stays
+// the same: O(min(p, n)) setup, then O(log_p n) per query.
 
 long long lucasNCR(int n, int r, int p) {
-    if(r == 0) return 1;
-    int ni = n % p, ri = r % p;
-    if(ni < ri) return 0;
-    return (nCr(ni, ri, p) * lucasNCR(n / p, r / p, p)) % p;
+    if(r < 0 || r > n) return 0;
+    
+    struct Table {
+        int p = 0;
+        vector<uint32_t> fact, invFact;
+    };
+    thread_local Table t;
+    if(t.p != p) {
+        t.p = p;
+        t.fact.assign(1, 1);
+        t.invFact.assign(1, 1);
+    }
+    
+    int need = min(p - 1, max(n, 0));
+    int have = t.fact.size() - 1;
+    if(need > have) {
+        t.fact.resize(need + 1);
+        t.invFact.resize(need + 1);
+        for(int i = have + 1; i <= need; i++) t.fact[i] = (uint64_t)t.fact[i - 1] * i % p;
+        t.invFact[need] = modPow(t.fact[need], p - 2, p);
+        for(int i = need; i > have + 1; i--) t.invFact[i - 1] = (uint64_t)t.invFact[i] * i % p;
+    }
+    
+    long long result = 1 % p;
+    while(r > 0 && result != 0) {
+        int ni = n % p, ri = r % p;
+        if(ni < ri) return 0;
+        result = result * t.fact[ni] % p * t.invFact[ri] % p * t.invFact[ni - ri] % p;
+        n /= p;
+        r /= p;
+    }
+    return result;
 }
 
+// Generalization to any modulus (Granville): split mod into prime powers q = p^e,
+// compute nCr mod each q, and combine with CRT.
+// With F(n) = n! with every factor p removed (mod q) and v(n) = power of p in n!,
+//   nCr = F(n) / (F(r) F(n - r)) * p^(v(n) - v(r) - v(n - r))   (mod q)
+// F(n) = (+-1)^(n / q) * f[n mod q] * F(n / p), where f[i] is the product of
+// 1..i skipping multiples of p. Setup O(sum of q) memory and time, then
+// O(log n) per prime power per query. Fits any mod < 2^32 whose prime powers
+// are small enough to tabulate (10^6, 2^20, 3^13, ...).
+struct BinomialMod {
+    struct PrimePower {
+        uint64_t p, q;
+        int e;
+        vector<uint32_t> f;   // f[i] = product of j <= i with p not dividing j, mod q
+    };
+    
+    uint64_t mod;
+    vector<PrimePower> parts;
+    GarnerCRT crt;
+    
+    BinomialMod(uint32_t mod) : mod(mod) {
+        vector<uint64_t> moduli;
+        uint64_t rest = mod;
+        for(uint64_t p = 2; rest > 1; p++) {
+            if(p * p > rest) p = rest;  // What is left is prime
+            if(rest % p != 0) continue;
+            
+            PrimePower pp;
+            pp.p = p;
+            pp.e = 0;
+            pp.q = 1;
+            while(rest % p == 0) {
+                rest /= p;
+                pp.e++;
+                pp.q *= p;
+            }
+            
+            pp.f.resize(pp.q);
+            pp.f[0] = 1 % pp.q;
+            for(uint64_t i = 1; i < pp.q; i++) {
+                pp.f[i] = (i % pp.p == 0) ? pp.f[i - 1] : pp.f[i - 1] * i % pp.q;
+            }
+            parts.push_back(pp);
+            moduli.push_back(pp.q);
+        }
+        crt = GarnerCRT(moduli);
+    }
+    
+    // Power of p dividing n! (Legendre)
+    static long long legendre(long long n, uint64_t p) {
+        long long v = 0;
+        while(n > 0) {
+            n /= p;
+            v += n;
+        }
+        return v;
+    }
+    
+    // n! without factors of p, mod q
+    static uint64_t factorialWithoutP(long long n, const PrimePower &pp) {
+        uint64_t result = 1 % pp.q;
+        // f[q - 1] is always +-1 mod q, so its power only depends on parity
+        bool negate = pp.f[pp.q - 1] != 1 % pp.q;
+        while(n > 0) {
+            if(negate && (n / pp.q) % 2 == 1) result = (pp.q - result) % pp.q;
+            result = result * pp.f[n % pp.q] % pp.q;
+            n /= pp.p;
+        }
+        return result;
+    }
+    
+    uint64_t nCr(long long n, long long r) const {
+        if(r < 0 || r > n || mod == 1) return 0;
+        
+        vector<uint64_t> residues(parts.size());
+        for(size_t i = 0; i < parts.size(); i++) {
+            const PrimePower &pp = parts[i];
+            long long v = legendre(n, pp.p) - legendre(r, pp.p) - legendre(n - r, pp.p);
+            if(v >= pp.e) {
+                residues[i] = 0;
+                continue;
+            }
+            
+            uint64_t num = factorialWithoutP(n, pp);
+            uint64_t den = factorialWithoutP(r, pp) * factorialWithoutP(n - r, pp) % pp.q;
+            uint64_t value = num * modInverseGeneral(den, pp.q) % pp.q;
+            for(long long i = 0; i < v; i++) value = value * pp.p % pp.q;
+            residues[i] = value;
+        }
+        
+        return crt.reconstruct(residues.data(), mod);
+    }
+};
+
 // ===== 9. CATALAN NUMBERS =====
 // C(n) = (2n)! / ((n+1)! * n!)
 // Sequence: 1, 1, 2, 5, 14, 42, 132, ...
@@ -365,42 +1150,1520 @@ long long fibonacci(long long n, long long mod = MOD) {
     return result[0][0];
 }
 
-// ===== MAIN FUNCTION =====
-int main() {
-    // Prime check
-    cout << "Is 17 prime? " << isPrime(17) << endl;
+// Fixed-size matrix for linear recurrences (k up to ~64).
+// Compile-time N, one contiguous array, entries kept in [0, M).
+// multiply() accumulates rows in uint64_t and reduces only every LAZY
+// terms (as many (M-1)^2 products as fit in 64 bits - 18 for 1e9+7,
+// capped at N so small moduli don't overflow the block size),
+// and the i-k-j loop order lets the compiler vectorize the inner loop.
+template<int N, uint32_t M = MOD>
+struct Matrix {
+    static_assert(M >= 2, "Matrix modulus must be at least 2");
+    static constexpr int LAZY = (int)min<uint64_t>(N, (UINT64_MAX - M) / ((uint64_t)(M - 1) * (M - 1)));
+    uint32_t a[N * N];
     
-    // Sieve
-    vector<bool> primes = sieveOfEratosthenes(50);
-    cout << "Primes up to 50: ";
-    for(int i = 2; i <= 50; i++) {
-        if(primes[i]) cout << i << " ";
+    uint32_t* operator[](int i) { return a + i * N; }
+    const uint32_t* operator[](int i) const { return a + i * N; }
+    
+    static Matrix identity() {
+        Matrix m = {};
+        for(int i = 0; i < N; i++) m[i][i] = 1;
+        return m;
     }
-    cout << endl;
+};
+
+// c = a * b (c must not alias a or b) - O(N^3) multiplies, O(N^3 / LAZY) reductions
+template<int N, uint32_t M>
+void multiply(const Matrix<N, M> &a, const Matrix<N, M> &b, Matrix<N, M> &c) {
+    const int LAZY = Matrix<N, M>::LAZY;
+    uint64_t acc[N];
     
-    // GCD and LCM
-    cout << "GCD(48, 18) = " << gcd(48, 18) << endl;
-    cout << "LCM(48, 18) = " << lcm(48, 18) << endl;
+    for(int i = 0; i < N; i++) {
+        for(int j = 0; j < N; j++) acc[j] = 0;
+        
+        for(int k0 = 0; k0 < N; k0 += LAZY) {
+            int k1 = min(N, k0 + LAZY);
+            for(int k = k0; k < k1; k++) {
+                uint64_t aik = a[i][k];
+                const uint32_t *bk = b[k];
+                for(int j = 0; j < N; j++) acc[j] += aik * bk[j];
+            }
+            // Keep one residue (< M) so the next block still fits
+            for(int j = 0; j < N; j++) acc[j] %= M;
+        }
+        
+        for(int j = 0; j < N; j++) c[i][j] = acc[j];
+    }
+}
+
+// base^exp with two ping-pong buffers each for result and base (no copies per step)
+template<int N, uint32_t M>
+Matrix<N, M> matPow(const Matrix<N, M> &base, uint64_t exp) {
+    Matrix<N, M> res[2] = {Matrix<N, M>::identity(), {}};
+    Matrix<N, M> pw[2] = {base, {}};
+    int r = 0, p = 0;
     
-    // Prime factors
-    vector<pair<int, int>> factors = primeFactors(60);
-    cout << "Prime factors of 60: ";
-    for(auto &f : factors) {
-        cout << f.first << "^" << f.second << " ";
+    while(exp > 0) {
+        if(exp & 1) {
+            multiply(res[r], pw[p], res[r ^ 1]);
+            r ^= 1;
+        }
+        exp >>= 1;
+        if(exp > 0) {
+            multiply(pw[p], pw[p], pw[p ^ 1]);
+            p ^= 1;
+        }
     }
-    cout << endl;
     
-    // Modular exponentiation
-    cout << "2^10 mod 1000 = " << modPow(2, 10, 1000) << endl;
+    return res[r];
+}
+
+// F(n) mod M with Matrix<2>
+template<uint32_t M = MOD>
+uint32_t fibonacciFast(uint64_t n) {
+    if(n <= 1) return n;
+    Matrix<2, M> base = {{1, 1, 1, 0}};
+    return matPow(base, n - 1)[0][0];
+}
+
+// a[n] for a[i] = c[0] * a[i-1] + ... + c[K-1] * a[i-K], given a[0..K-1]
+template<int K, uint32_t M = MOD>
+uint32_t linearRecurrence(const uint32_t (&c)[K], const uint32_t (&init)[K], uint64_t n) {
+    if(n < (uint64_t)K) return init[n];
     
-    // Combinations
-    cout << "C(5, 2) = " << nCr(5, 2) << endl;
+    // Companion matrix: first row = coefficients, then a shifted identity
+    Matrix<K, M> t = {};
+    for(int j = 0; j < K; j++) t[0][j] = c[j] % M;
+    for(int i = 1; i < K; i++) t[i][i - 1] = 1;
     
-    // Euler Totient
-    cout << "φ(10) = " << eulerTotient(10) << endl;
+    Matrix<K, M> p = matPow(t, n - K + 1);
+    // State vector is (a[K-1], ..., a[0]); a[n] is the first row times it
+    uint64_t result = 0;
+    for(int j = 0; j < K; j++) {
+        result = (result + (uint64_t)p[0][j] * init[K - 1 - j]) % M;
+    }
+    return result;
+}
+
+// Old vector<vector> matrixPower vs Matrix<N> for Fibonacci and a 64-term recurrence
+void benchmarkMatrixPower() {
+    auto ms = [](auto &&body) {
+        auto start = chrono::steady_clock::now();
+        body();
+        return chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+    };
     
-    // Fibonacci
-    cout << "F(10) = " << fibonacci(10) << endl;
+    const int FIB_QUERIES = 100000;
+    long long sumOld = 0, sumNew = 0;
+    double tFibOld = ms([&]() {
+        for(int i = 0; i < FIB_QUERIES; i++) sumOld += fibonacci(1000000000000LL + i);
+    });
+    double tFibNew = ms([&]() {
+        for(int i = 0; i < FIB_QUERIES; i++) sumNew += fibonacciFast(1000000000000ULL + i);
+    });
+    cout << FIB_QUERIES << " x F(~10^12): matrixPower " << tFibOld << " ms, Matrix<2> "
+         << tFibNew << " ms" << (sumOld == sumNew ? "" : " (MISMATCH)") << endl;
+    
+    const int K = 64;
+    uint32_t c[K], init[K];
+    vector<vector<long long>> t(K, vector<long long>(K, 0));
+    for(int j = 0; j < K; j++) {
+        c[j] = t[0][j] = (j * 7919 + 13) % MOD;
+        init[j] = j + 1;
+    }
+    for(int i = 1; i < K; i++) t[i][i - 1] = 1;
+    
+    uint64_t n = 1000000000000000000ULL;
+    long long oldValue = 0;
+    uint32_t newValue = 0;
+    double tRecOld = ms([&]() {
+        vector<vector<long long>> p = matrixPower(t, n - K + 1);
+        for(int j = 0; j < K; j++) oldValue = (oldValue + p[0][j] * init[K - 1 - j]) % MOD;
+    });
+    double tRecNew = ms([&]() { newValue = linearRecurrence<K>(c, init, n); });
+    cout << "64-term recurrence at n = 10^18: matrixPower " << tRecOld << " ms, Matrix<64> "
+         << tRecNew << " ms" << (oldValue == newValue ? "" : " (MISMATCH)") << endl;
+}
+
+// ===== 11. LINEAR SIEVE (SMALLEST PRIME FACTOR) =====
+// Euler's sieve: every composite is crossed off exactly once, by its
+// smallest prime factor - O(n). In the same pass it fills phi, mu,
+// d (number of divisors) and sigma (sum of divisors).
+// After that, factorizing any x <= n takes O(log x) divisions by spf[x].
+//
+// Memory is about 23 bytes per number with tables (2.3 GB at 10^8),
+// 4 bytes per number with withTables = false (spf only).
+
+struct LinearSieve {
+    int n;
+    vector<int> spf;            // Smallest prime factor, spf[0] = spf[1] = 0
+    vector<int> primes;
+    vector<int> phi;            // Euler's totient
+    vector<signed char> mu;     // Mobius function
+    vector<int> divCount;       // d(x)
+    vector<long long> divSum;   // sigma(x)
+    
+    LinearSieve(int n, bool withTables = true) : n(n), spf(n + 1, 0) {
+        // lpPow[x] = p^e, the full power of spf[x] dividing x
+        vector<int> lpPow;
+        if(withTables) {
+            phi.assign(n + 1, 0);
+            mu.assign(n + 1, 0);
+            divCount.assign(n + 1, 0);
+            divSum.assign(n + 1, 0);
+            lpPow.assign(n + 1, 0);
+            if(n >= 1) {
+                phi[1] = mu[1] = divCount[1] = divSum[1] = 1;
+            }
+        }
+        
+        for(int i = 2; i <= n; i++) {
+            if(spf[i] == 0) {
+                spf[i] = i;
+                primes.push_back(i);
+                if(withTables) {
+                    phi[i] = i - 1;
+                    mu[i] = -1;
+                    divCount[i] = 2;
+                    divSum[i] = i + 1;
+                    lpPow[i] = i;
+                }
+            }
+            
+            for(int p : primes) {
+                if(p > spf[i] || (long long)i * p > n) break;
+                int x = i * p;
+                spf[x] = p;
+                if(!withTables) continue;
+                
+                if(p == spf[i]) {
+                    // p already divides i: raise the power of p
+                    int rest = i / lpPow[i];
+                    lpPow[x] = lpPow[i] * p;
+                    phi[x] = phi[i] * p;
+                    mu[x] = 0;
+                    divCount[x] = divCount[rest] * (divCount[lpPow[i]] + 1);
+                    divSum[x] = divSum[rest] * (divSum[lpPow[i]] * p + 1);
+                } else {
+                    // p is new: f(i * p) = f(i) * f(p)
+                    lpPow[x] = p;
+                    phi[x] = phi[i] * (p - 1);
+                    mu[x] = -mu[i];
+                    divCount[x] = divCount[i] * 2;
+                    divSum[x] = divSum[i] * (p + 1);
+                }
+            }
+        }
+    }
+    
+    bool hasTables() const { return !phi.empty(); }
+    
+    // O(log x) factorization using spf
+    vector<pair<int, int>> factorize(int x) const {
+        vector<pair<int, int>> factors;
+        while(x > 1) {
+            int p = spf[x], count = 0;
+            while(x % p == 0) {
+                x /= p;
+                count++;
+            }
+            factors.push_back({p, count});
+        }
+        return factors;
+    }
+};
+
+// Batch versions of primeFactors / countDivisors / sumOfDivisors / eulerTotient.
+// Every value must be in [1, sieve.n]. O(1) per value with tables, O(log x) without.
+
+vector<vector<pair<int, int>>> primeFactors(const vector<int> &nums, const LinearSieve &sieve) {
+    vector<vector<pair<int, int>>> result;
+    result.reserve(nums.size());
+    for(int x : nums) {
+        result.push_back(sieve.factorize(x));
+    }
+    return result;
+}
+
+vector<int> countDivisors(const vector<int> &nums, const LinearSieve &sieve) {
+    vector<int> result;
+    result.reserve(nums.size());
+    for(int x : nums) {
+        if(sieve.hasTables()) {
+            result.push_back(sieve.divCount[x]);
+            continue;
+        }
+        int count = 1;
+        for(auto &factor : sieve.factorize(x)) {
+            count *= (factor.second + 1);
+        }
+        result.push_back(count);
+    }
+    return result;
+}
+
+vector<long long> sumOfDivisors(const vector<int> &nums, const LinearSieve &sieve) {
+    vector<long long> result;
+    result.reserve(nums.size());
+    for(int x : nums) {
+        if(sieve.hasTables()) {
+            result.push_back(sieve.divSum[x]);
+            continue;
+        }
+        long long sum = 1;
+        for(auto &factor : sieve.factorize(x)) {
+            long long term = 1;
+            for(int i = 1; i <= factor.second; i++) {
+                term = term * factor.first + 1;
+            }
+            sum *= term;
+        }
+        result.push_back(sum);
+    }
+    return result;
+}
+
+vector<int> eulerTotient(const vector<int> &nums, const LinearSieve &sieve) {
+    vector<int> result;
+    result.reserve(nums.size());
+    for(int x : nums) {
+        if(sieve.hasTables()) {
+            result.push_back(sieve.phi[x]);
+            continue;
+        }
+        int phi = x;
+        for(auto &factor : sieve.factorize(x)) {
+            phi -= phi / factor.first;
+        }
+        result.push_back(phi);
+    }
+    return result;
+}
+
+// ===== 12. 64-BIT PRIMALITY AND FACTORIZATION =====
+// isPrime() / primeFactors() above are trial division on int. For 64-bit
+// values: Miller-Rabin (deterministic with the first 12 primes as bases)
+// and Pollard-Brent rho, with all mulmods done in Montgomery form
+// (one 128-bit multiply + no division per step).
+
+// Montgomery arithmetic for an odd modulus m < 2^64.
+// Values are kept as x * 2^64 mod m; reduce() divides by 2^64.
+struct Montgomery64 {
+    uint64_t mod, inv, r2;  // inv = mod^-1 mod 2^64, r2 = 2^128 mod mod
+    
+    Montgomery64(uint64_t m) : mod(m), inv(m) {
+        for(int i = 0; i < 5; i++) inv *= 2 - m * inv;  // Newton: 3 -> 96 bits
+        uint64_t r = -m % m;                             // 2^64 mod m
+        r2 = (u128)r * r % m;
+    }
+    
+    uint64_t reduce(u128 x) const {
+        uint64_t q = (uint64_t)x * inv;
+        uint64_t hi = x >> 64, sub = ((u128)q * mod) >> 64;
+        return hi >= sub ? hi - sub : hi - sub + mod;
+    }
+    
+    uint64_t to(uint64_t x) const { return reduce((u128)(x % mod) * r2); }
+    uint64_t from(uint64_t x) const { return reduce(x); }
+    uint64_t mul(uint64_t a, uint64_t b) const { return reduce((u128)a * b); }
+    
+    uint64_t add(uint64_t a, uint64_t b) const {
+        a += b;
+        return (a < b || a >= mod) ? a - mod : a;
+    }
+    
+    uint64_t pow(uint64_t base, uint64_t exp) const {  // base in Montgomery form
+        uint64_t result = to(1);
+        while(exp > 0) {
+            if(exp & 1) result = mul(result, base);
+            base = mul(base, base);
+            exp >>= 1;
+        }
+        return result;
+    }
+};
+
+// Deterministic for all n < 2^64 - O(12 log n) mulmods
+bool isPrime64(uint64_t n) {
+    const uint64_t BASES[12] = {2, 3, 5, 7, 11, 13, 17, 19, 23, 29, 31, 37};
+    if(n < 2) return false;
+    for(uint64_t p : BASES) {
+        if(n % p == 0) return n == p;
+    }
+    if(n < 37 * 37) return true;
+    
+    // n - 1 = d * 2^s
+    uint64_t d = n - 1;
+    int s = __builtin_ctzll(d);
+    d >>= s;
+    
+    Montgomery64 mg(n);
+    uint64_t one = mg.to(1), minusOne = mg.to(n - 1);
+    
+    for(uint64_t a : BASES) {
+        uint64_t x = mg.pow(mg.to(a), d);
+        if(x == one || x == minusOne) continue;
+        
+        bool composite = true;
+        for(int r = 1; r < s; r++) {
+            x = mg.mul(x, x);
+            if(x == minusOne) {
+                composite = false;
+                break;
+            }
+        }
+        if(composite) return false;
+    }
+    
+    return true;
+}
+
+// Pollard-Brent rho: returns a non-trivial factor of odd composite n
+uint64_t pollardRho(uint64_t n) {
+    static mt19937_64 rng(0x9E3779B97F4A7C15ULL);
+    Montgomery64 mg(n);
+    const int BATCH = 128;  // gcd once per BATCH steps
+    
+    while(true) {
+        uint64_t c = mg.to(rng() % (n - 1) + 1);
+        uint64_t y = mg.to(rng() % n), x = y, ys = y;
+        uint64_t g = 1, q = mg.to(1);
+        
+        for(uint64_t r = 1; g == 1; r <<= 1) {
+            x = y;
+            for(uint64_t i = 0; i < r; i++) y = mg.add(mg.mul(y, y), c);
+            
+            for(uint64_t k = 0; k < r && g == 1; k += BATCH) {
+                ys = y;
+                for(uint64_t i = 0; i < BATCH && i < r - k; i++) {
+                    y = mg.add(mg.mul(y, y), c);
+                    q = mg.mul(q, x > y ? x - y : y - x);
+                }
+                g = __gcd(mg.from(q), n);
+            }
+        }
+        
+        if(g == n) {
+            // Batch overshot: redo this stretch one step at a time
+            do {
+                ys = mg.add(mg.mul(ys, ys), c);
+                g = __gcd(x > ys ? x - ys : ys - x, n);
+            } while(g == 1);
+        }
+        
+        if(g != n) return g;
+    }
+}
+
+// Prime factorization of a 64-bit value, sorted by prime
+vector<pair<uint64_t, int>> primeFactors64(uint64_t n) {
+    vector<uint64_t> primes;
+    
+    for(uint64_t p = 2; p < 100 && p * p <= n; p += (p == 2 ? 1 : 2)) {
+        while(n % p == 0) {
+            primes.push_back(p);
+            n /= p;
+        }
+    }
+    
+    vector<uint64_t> work;
+    if(n > 1) work.push_back(n);
+    while(!work.empty()) {
+        uint64_t x = work.back();
+        work.pop_back();
+        if(isPrime64(x)) {
+            primes.push_back(x);
+        } else {
+            uint64_t f = pollardRho(x);
+            work.push_back(f);
+            work.push_back(x / f);
+        }
+    }
+    
+    sort(primes.begin(), primes.end());
+    vector<pair<uint64_t, int>> factors;
+    for(uint64_t p : primes) {
+        if(!factors.empty() && factors.back().first == p) {
+            factors.back().second++;
+        } else {
+            factors.push_back({p, 1});
+        }
+    }
+    
+    return factors;
+}
+
+// Factorizations per second on random 62-bit semiprimes (two 31-bit primes)
+void benchmarkFactorization(int count) {
+    mt19937_64 rng(42);
+    auto randomPrime31 = [&]() {
+        while(true) {
+            uint64_t x = (rng() & 0x7FFFFFFF) | 0x40000001;  // Odd, exactly 31 bits
+            if(isPrime64(x)) return x;
+        }
+    };
+    
+    vector<uint64_t> semiprimes(count);
+    for(auto &x : semiprimes) x = randomPrime31() * randomPrime31();
+    
+    auto start = chrono::steady_clock::now();
+    int ok = 0;
+    for(uint64_t x : semiprimes) {
+        vector<pair<uint64_t, int>> f = primeFactors64(x);
+        uint64_t product = 1;
+        for(auto &p : f) for(int i = 0; i < p.second; i++) product *= p.first;
+        ok += (product == x);
+    }
+    double secs = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+    
+    cout << "Factored " << ok << "/" << count << " 62-bit semiprimes, "
+         << (long long)(count / secs) << " per second" << endl;
+}
+
+// ===== 13. POWER ENGINE =====
+// Faster exponentiation for ModInt / DynamicModInt values:
+//   powWindow   - sliding window (4 bits): ~log2(e) squarings + log2(e)/5 multiplies.
+//                  Fewer multiplies, but one dependency chain; the plain
+//                  right-to-left ladder overlaps its two chains, so the window
+//                  only wins when a multiply is expensive (matrices, polynomials)
+//   FixedBasePow - many exponents, same base: table of base^(d * 256^i),
+//                  then a 64-bit exponent costs 7 multiplies, no squarings
+//   batchPow    - many independent powers; 8 ladders run interleaved so the
+//                  CPU overlaps their multiply latencies
+
+template<class Mint>
+Mint powWindow(Mint base, uint64_t exp) {
+    const int W = 4;
+    if(exp == 0) return Mint(1);
+    
+    // odd[i] = base^(2i + 1)
+    Mint odd[1 << (W - 1)];
+    Mint sq = base * base;
+    odd[0] = base;
+    for(int i = 1; i < (1 << (W - 1)); i++) odd[i] = odd[i - 1] * sq;
+    
+    Mint result = 1;
+    int bit = 63 - __builtin_clzll(exp);
+    while(bit >= 0) {
+        if(!((exp >> bit) & 1)) {
+            result *= result;
+            bit--;
+            continue;
+        }
+        // Longest window of <= W bits starting at `bit` and ending in a 1
+        int low = max(bit - W + 1, 0);
+        while(!((exp >> low) & 1)) low++;
+        int len = bit - low + 1;
+        uint64_t window = (exp >> low) & ((1ULL << len) - 1);
+        for(int i = 0; i < len; i++) result *= result;
+        result *= odd[window >> 1];
+        bit = low - 1;
+    }
+    
+    return result;
+}
+
+template<class Mint>
+struct FixedBasePow {
+    static const int DIGIT_BITS = 8;
+    int digits;
+    vector<Mint> table;  // table[i * 256 + d] = base^(d * 256^i)
+    Mint high;           // base^(256^digits), for exponent bits past the table
+    
+    FixedBasePow(Mint base, int maxExpBits = 64) {
+        maxExpBits = max(maxExpBits, 1);
+        digits = (maxExpBits + DIGIT_BITS - 1) / DIGIT_BITS;
+        table.resize(digits << DIGIT_BITS);
+        for(int i = 0; i < digits; i++) {
+            Mint *row = &table[i << DIGIT_BITS];
+            row[0] = 1;
+            for(int d = 1; d < (1 << DIGIT_BITS); d++) row[d] = row[d - 1] * base;
+            base = row[(1 << DIGIT_BITS) - 1] * base;  // base^(256^(i + 1))
+        }
+        high = base;
+    }
+    
+    // Bits beyond maxExpBits are handled by powWindow on `high`
+    Mint pow(uint64_t exp) const {
+        Mint result = table[exp & 0xFF];
+        exp >>= DIGIT_BITS;
+        for(int i = 1; i < digits && exp > 0; i++, exp >>= DIGIT_BITS) {
+            result *= table[(i << DIGIT_BITS) | (exp & 0xFF)];
+        }
+        if(exp > 0) result *= powWindow(high, exp);
+        return result;
+    }
+};
+
+// out[i] = bases[i] ^ exps[i]
+template<class Mint>
+void batchPow(const Mint *bases, const uint64_t *exps, Mint *out, size_t n) {
+    const int LANES = 8;
+    size_t i = 0;
+    for(; i + LANES <= n; i += LANES) {
+        Mint result[LANES], base[LANES];
+        uint64_t e[LANES], any = 0;
+        for(int l = 0; l < LANES; l++) {
+            result[l] = 1;
+            base[l] = bases[i + l];
+            e[l] = exps[i + l];
+            any |= e[l];
+        }
+        // Runs for the longest exponent in the group; the 8 chains are independent
+        Mint one = 1;
+        while(any) {
+            any = 0;
+            for(int l = 0; l < LANES; l++) {
+                result[l] *= (e[l] & 1) ? base[l] : one;  // Branch-free: bits are random
+                base[l] *= base[l];
+                e[l] >>= 1;
+                any |= e[l];
+            }
+        }
+        for(int l = 0; l < LANES; l++) out[i + l] = result[l];
+    }
+    for(; i < n; i++) out[i] = powWindow(bases[i], exps[i]);
+}
+
+// out[i] = bases[i] ^ exp (same exponent: one bit pattern, no per-lane branches)
+template<class Mint>
+void batchPow(const Mint *bases, uint64_t exp, Mint *out, size_t n) {
+    const int LANES = 8;
+    size_t i = 0;
+    for(; i + LANES <= n; i += LANES) {
+        Mint result[LANES], base[LANES];
+        for(int l = 0; l < LANES; l++) {
+            result[l] = 1;
+            base[l] = bases[i + l];
+        }
+        for(uint64_t e = exp; e > 0; e >>= 1) {
+            if(e & 1) {
+                for(int l = 0; l < LANES; l++) result[l] *= base[l];
+            }
+            for(int l = 0; l < LANES; l++) base[l] *= base[l];
+        }
+        for(int l = 0; l < LANES; l++) out[i + l] = result[l];
+    }
+    for(; i < n; i++) out[i] = powWindow(bases[i], exp);
+}
+
+// Throughput of each strategy against the plain modPow ladder
+void benchmarkPowers(int n) {
+    typedef ModInt<MOD> mint;
+    mt19937_64 rng(99);
+    vector<long long> rawBases(n);
+    vector<uint64_t> exps(n);
+    for(int i = 0; i < n; i++) {
+        rawBases[i] = rng() % MOD;
+        exps[i] = rng() % (MOD - 1);
+    }
+    vector<mint> bases(rawBases.begin(), rawBases.end()), out(n);
+    vector<long long> expected(n);
+    
+    auto rate = [&](auto &&body) {
+        auto start = chrono::steady_clock::now();
+        body();
+        double secs = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+        return n / secs / 1e6;
+    };
+    auto check = [&]() {
+        for(int i = 0; i < n; i++) if(out[i].val() != expected[i]) return " (MISMATCH)";
+        return "";
+    };
+    
+    cout << "Powers per second (millions), n = " << n << endl;
+    cout << "  modPow:               " << rate([&]() {
+        for(int i = 0; i < n; i++) expected[i] = modPow(rawBases[i], exps[i]);
+    }) << endl;
+    cout << "  powWindow:            " << rate([&]() {
+        for(int i = 0; i < n; i++) out[i] = powWindow(bases[i], exps[i]);
+    }) << check() << endl;
+    cout << "  batchPow:             " << rate([&]() {
+        batchPow(bases.data(), exps.data(), out.data(), n);
+    }) << check() << endl;
+    
+    // Longer exponents
+    vector<uint64_t> longExps(n);
+    for(int i = 0; i < n; i++) longExps[i] = rng() >> 2;
+    for(int i = 0; i < n; i++) expected[i] = modPow(rawBases[i], longExps[i]);
+    cout << "  modPow (62-bit e):    " << rate([&]() {
+        for(int i = 0; i < n; i++) expected[i] = modPow(rawBases[i], longExps[i]);
+    }) << endl;
+    cout << "  powWindow (62-bit e): " << rate([&]() {
+        for(int i = 0; i < n; i++) out[i] = powWindow(bases[i], longExps[i]);
+    }) << check() << endl;
+    
+    // Same base (e.g. rolling-hash powers)
+    for(int i = 0; i < n; i++) expected[i] = modPow(rawBases[0], exps[i]);
+    FixedBasePow<mint> fixedBase(bases[0], 30);
+    cout << "  FixedBasePow:         " << rate([&]() {
+        for(int i = 0; i < n; i++) out[i] = fixedBase.pow(exps[i]);
+    }) << check() << endl;
+    
+    // Same exponent (e.g. Fermat inverses)
+    for(int i = 0; i < n; i++) expected[i] = modPow(rawBases[i], MOD - 2);
+    cout << "  batchPow (same e):    " << rate([&]() {
+        batchPow(bases.data(), (uint64_t)(MOD - 2), out.data(), n);
+    }) << check() << endl;
+}
+
+// ===== 14. LINEAR RECURRENCES (BERLEKAMP-MASSEY, KITAMASA) =====
+// Berlekamp-Massey finds the shortest recurrence
+//   a[i] = c[0] * a[i-1] + c[1] * a[i-2] + ... + c[k-1] * a[i-k]
+// from 2k sample terms - O(N^2) for N samples (prime modulus).
+// Kitamasa then gives a[n] as x^n mod (characteristic polynomial):
+// O(k^2 log n) instead of the O(k^3 log n) of the matrix power.
+
+template<uint32_t M = MOD>
+vector<ModInt<M>> berlekampMassey(const vector<ModInt<M>> &s) {
+    typedef ModInt<M> mint;
+    vector<mint> C = {1}, B = {1};  // Current and previous connection polynomials
+    int L = 0, shift = 1;
+    mint lastDiscrepancy = 1;
+    
+    for(size_t n = 0; n < s.size(); n++) {
+        mint d = s[n];
+        for(int i = 1; i <= L; i++) d += C[i] * s[n - i];
+        if(d == mint(0)) {
+            shift++;
+            continue;
+        }
+        
+        vector<mint> T = C;
+        mint coef = d / lastDiscrepancy;
+        if(C.size() < B.size() + shift) C.resize(B.size() + shift);
+        for(size_t i = 0; i < B.size(); i++) C[i + shift] -= coef * B[i];
+        
+        if(2 * L <= (int)n) {
+            L = n + 1 - L;
+            B = T;
+            lastDiscrepancy = d;
+            shift = 1;
+        } else {
+            shift++;
+        }
+    }
+    
+    vector<mint> c(L);
+    for(int j = 0; j < L; j++) c[j] = -C[j + 1];
+    return c;
+}
+
+// a * b mod (x^k - c[0] x^(k-1) - ... - c[k-1]), both of degree < k
+template<uint32_t M>
+vector<ModInt<M>> polyMulModCharPoly(const vector<ModInt<M>> &a, const vector<ModInt<M>> &b,
+                                     const vector<ModInt<M>> &c) {
+    typedef ModInt<M> mint;
+    int k = c.size();
+    vector<mint> prod(2 * k - 1);
+    for(int i = 0; i < k; i++) {
+        if(a[i] == mint(0)) continue;
+        for(int j = 0; j < k; j++) prod[i + j] += a[i] * b[j];
+    }
+    // x^i = c[0] x^(i-1) + ... + c[k-1] x^(i-k), folded from the top down
+    for(int i = 2 * k - 2; i >= k; i--) {
+        if(prod[i] == mint(0)) continue;
+        for(int j = 0; j < k; j++) prod[i - 1 - j] += prod[i] * c[j];
+    }
+    prod.resize(k);
+    return prod;
+}
+
+// a[n] given the recurrence c and the first k terms - O(k^2 log n)
+template<uint32_t M = MOD>
+ModInt<M> kitamasa(const vector<ModInt<M>> &c, const vector<ModInt<M>> &init, uint64_t n) {
+    typedef ModInt<M> mint;
+    int k = c.size();
+    if(k == 0) return 0;
+    if(n < (uint64_t)k) return init[n];
+    
+    // r = x^n mod charpoly, built from the top bit down
+    vector<mint> r(k);
+    r[0] = 1;
+    for(int bit = 63 - __builtin_clzll(n); bit >= 0; bit--) {
+        r = polyMulModCharPoly(r, r, c);
+        if((n >> bit) & 1) {
+            // Multiply by x: shift up and fold the x^k term back
+            mint top = r[k - 1];
+            for(int i = k - 1; i > 0; i--) r[i] = r[i - 1] + top * c[k - 1 - i];
+            r[0] = top * c[k - 1];
+        }
+    }
+    
+    mint result = 0;
+    for(int i = 0; i < k; i++) result += r[i] * init[i];
+    return result;
+}
+
+// n-th term of a sequence that satisfies some linear recurrence, from its first
+// terms (give at least twice the recurrence order)
+template<uint32_t M = MOD>
+ModInt<M> nthTermFromSamples(const vector<long long> &samples, uint64_t n) {
+    vector<ModInt<M>> s(samples.begin(), samples.end());
+    if(n < s.size()) return s[n];
+    vector<ModInt<M>> c = berlekampMassey(s);
+    s.resize(c.size());
+    return kitamasa(c, s, n);
+}
+
+// ===== 15. NUMBER THEORETIC TRANSFORM (NTT) =====
+// Polynomial multiplication (convolution) in O(n log n) modulo a prime
+// p = c * 2^k + 1 that has 2^k-th roots of unity, e.g. 998244353 = 119 * 2^23 + 1.
+// Counting DPs like coinChangeWays() are coefficients of polynomial
+// products, which is where this pays off.
+//
+// forward() is decimation-in-frequency (natural order in, bit-reversed out)
+// and inverse() is decimation-in-time (bit-reversed in, natural out), so
+// a convolution never needs the bit-reversal permutation. Both process
+// two levels at once (radix-4 butterflies) with twiddles read from
+// tables rt[s/2 + j] = w_s^j, and run 8 Montgomery lanes at a time with
+// AVX2 when the CPU has it.
+
+#if defined(__x86_64__) || defined(__i386__)
+__attribute__((target("avx2")))
+inline __m256i addModAVX2(__m256i a, __m256i b, __m256i m) {
+    __m256i r = _mm256_add_epi32(a, b);
+    return _mm256_min_epu32(r, _mm256_sub_epi32(r, m));
+}
+
+__attribute__((target("avx2")))
+inline __m256i subModAVX2(__m256i a, __m256i b, __m256i m) {
+    __m256i r = _mm256_sub_epi32(a, b);
+    return _mm256_min_epu32(r, _mm256_add_epi32(r, m));  // Fixes the wrapped case
+}
+
+// One radix-4 DIF block of 4q values (q multiple of 8), all in Montgomery form
+__attribute__((target("avx2")))
+void radix4DifAVX2(uint32_t *a, int q, const uint32_t *rt, uint32_t mod, uint32_t negInv, uint32_t imag) {
+    __m256i m = _mm256_set1_epi32(mod), ni = _mm256_set1_epi32(negInv), im = _mm256_set1_epi32(imag);
+    uint32_t *a0 = a, *a1 = a + q, *a2 = a + 2 * q, *a3 = a + 3 * q;
+    const uint32_t *w1 = rt + 2 * q, *w2 = rt + q;
+    for(int j = 0; j < q; j += 8) {
+        __m256i x0 = _mm256_loadu_si256((__m256i*)(a0 + j)), x1 = _mm256_loadu_si256((__m256i*)(a1 + j));
+        __m256i x2 = _mm256_loadu_si256((__m256i*)(a2 + j)), x3 = _mm256_loadu_si256((__m256i*)(a3 + j));
+        __m256i t1w = _mm256_loadu_si256((const __m256i*)(w1 + j)), t2w = _mm256_loadu_si256((const __m256i*)(w2 + j));
+        __m256i t3w = montMulAVX2(t1w, t2w, m, ni);
+        
+        __m256i t0 = addModAVX2(x0, x2, m), t1 = addModAVX2(x1, x3, m);
+        __m256i t2 = subModAVX2(x0, x2, m), t3 = montMulAVX2(subModAVX2(x1, x3, m), im, m, ni);
+        _mm256_storeu_si256((__m256i*)(a0 + j), addModAVX2(t0, t1, m));
+        _mm256_storeu_si256((__m256i*)(a1 + j), montMulAVX2(subModAVX2(t0, t1, m), t2w, m, ni));
+        _mm256_storeu_si256((__m256i*)(a2 + j), montMulAVX2(addModAVX2(t2, t3, m), t1w, m, ni));
+        _mm256_storeu_si256((__m256i*)(a3 + j), montMulAVX2(subModAVX2(t2, t3, m), t3w, m, ni));
+    }
+}
+
+// Inverse of the block above (without the 1/4 factor)
+__attribute__((target("avx2")))
+void radix4DitAVX2(uint32_t *a, int q, const uint32_t *irt, uint32_t mod, uint32_t negInv, uint32_t imagInv) {
+    __m256i m = _mm256_set1_epi32(mod), ni = _mm256_set1_epi32(negInv), im = _mm256_set1_epi32(imagInv);
+    uint32_t *a0 = a, *a1 = a + q, *a2 = a + 2 * q, *a3 = a + 3 * q;
+    const uint32_t *w1 = irt + 2 * q, *w2 = irt + q;
+    for(int j = 0; j < q; j += 8) {
+        __m256i t1w = _mm256_loadu_si256((const __m256i*)(w1 + j)), t2w = _mm256_loadu_si256((const __m256i*)(w2 + j));
+        __m256i t3w = montMulAVX2(t1w, t2w, m, ni);
+        __m256i b0 = _mm256_loadu_si256((__m256i*)(a0 + j));
+        __m256i b1 = montMulAVX2(_mm256_loadu_si256((__m256i*)(a1 + j)), t2w, m, ni);
+        __m256i b2 = montMulAVX2(_mm256_loadu_si256((__m256i*)(a2 + j)), t1w, m, ni);
+        __m256i b3 = montMulAVX2(_mm256_loadu_si256((__m256i*)(a3 + j)), t3w, m, ni);
+        
+        __m256i x0 = addModAVX2(b0, b1, m), x1 = subModAVX2(b0, b1, m);
+        __m256i y0 = addModAVX2(b2, b3, m), y1 = montMulAVX2(subModAVX2(b2, b3, m), im, m, ni);
+        _mm256_storeu_si256((__m256i*)(a0 + j), addModAVX2(x0, y0, m));
+        _mm256_storeu_si256((__m256i*)(a2 + j), subModAVX2(x0, y0, m));
+        _mm256_storeu_si256((__m256i*)(a1 + j), addModAVX2(x1, y1, m));
+        _mm256_storeu_si256((__m256i*)(a3 + j), subModAVX2(x1, y1, m));
+    }
+}
+#endif
+
+template<uint32_t M, uint32_t G = 3>  // G: primitive root mod M
+struct NTT {
+    typedef ModInt<M> mint;
+    static const int MAX_LOG = __builtin_ctz(M - 1);  // Longest transform: 2^MAX_LOG
+    
+    // Twiddle tables shared by all transforms mod M, grown on demand:
+    // table(false)[s/2 + j] = w_s^j. Growth builds a larger copy under a
+    // mutex and then publishes it; superseded buffers are kept (together no
+    // bigger than the newest), so a transform running on another thread
+    // never has its table freed underneath it.
+    struct Tables {
+        mutex growLock;
+        atomic<const mint*> data[2] = {nullptr, nullptr};
+        atomic<int> size{0};
+        vector<vector<mint>> kept;
+    };
+    
+    static Tables& tables() {
+        static Tables t;
+        return t;
+    }
+    
+    static const mint* table(bool inverse) {
+        return tables().data[inverse].load(memory_order_acquire);
+    }
+    
+    static void prepare(int n) {
+        Tables &t = tables();
+        if(t.size.load(memory_order_acquire) >= n) return;
+        lock_guard<mutex> guard(t.growLock);
+        int have = t.size.load(memory_order_relaxed);
+        if(have >= n) return;
+        
+        int size = max(have, 2);
+        while(size < n) size *= 2;
+        for(int inv = 0; inv < 2; inv++) {
+            vector<mint> rt(size);
+            const mint *old = t.data[inv].load(memory_order_relaxed);
+            if(have) copy(old, old + have, rt.begin());
+            else rt[1] = 1;
+            for(int s = max(have, 2) * 2; s <= size; s *= 2) {
+                mint w = mint(G).pow((M - 1) / s);
+                if(inv) w = w.inv();
+                rt[s / 2] = 1;
+                for(int j = 1; j < s / 2; j++) rt[s / 2 + j] = rt[s / 2 + j - 1] * w;
+            }
+            t.kept.push_back(move(rt));  // Moving keeps the buffer in place
+            t.data[inv].store(t.kept.back().data(), memory_order_release);
+        }
+        t.size.store(size, memory_order_release);
+    }
+    
+    static mint imag() { static mint i = mint(G).pow((M - 1) / 4); return i; }  // w_4
+    
+    // DIF: natural order in, bit-reversed order out
+    static void forward(mint *a, int n) {
+        prepare(n);
+        const mint *rt = table(false);
+        int len = n;
+        
+        if(__builtin_ctz(n) & 1) {  // Odd number of levels: one radix-2 level first
+            int h = n / 2;
+            for(int j = 0; j < h; j++) {
+                mint u = a[j], v = a[j + h];
+                a[j] = u + v;
+                a[j + h] = (u - v) * rt[h + j];
+            }
+            len = h;
+        }
+        
+        mint I = imag();
+        for(; len >= 4; len /= 4) {
+            int q = len / 4;
+            for(int s = 0; s < n; s += len) {
+#if defined(__x86_64__) || defined(__i386__)
+                if(q >= 8 && cpuHasAVX2()) {
+                    radix4DifAVX2((uint32_t*)(a + s), q, (const uint32_t*)rt, M, mint::NEG_INV, I.v);
+                    continue;
+                }
+#endif
+                mint *a0 = a + s, *a1 = a0 + q, *a2 = a1 + q, *a3 = a2 + q;
+                for(int j = 0; j < q; j++) {
+                    mint w1 = rt[2 * q + j], w2 = rt[q + j];
+                    mint t0 = a0[j] + a2[j], t1 = a1[j] + a3[j];
+                    mint t2 = a0[j] - a2[j], t3 = (a1[j] - a3[j]) * I;
+                    a0[j] = t0 + t1;
+                    a1[j] = (t0 - t1) * w2;
+                    a2[j] = (t2 + t3) * w1;
+                    a3[j] = (t2 - t3) * (w1 * w2);
+                }
+            }
+        }
+    }
+    
+    // DIT: bit-reversed order in, natural order out, scaled by 1/n
+    static void inverse(mint *a, int n) {
+        prepare(n);
+        const mint *irt = table(true);
+        bool odd = __builtin_ctz(n) & 1;
+        int top = odd ? n / 2 : n;
+        
+        mint I = imag().inv();
+        for(int len = 4; len <= top; len *= 4) {
+            int q = len / 4;
+            for(int s = 0; s < n; s += len) {
+#if defined(__x86_64__) || defined(__i386__)
+                if(q >= 8 && cpuHasAVX2()) {
+                    radix4DitAVX2((uint32_t*)(a + s), q, (const uint32_t*)irt, M, mint::NEG_INV, I.v);
+                    continue;
+                }
+#endif
+                mint *a0 = a + s, *a1 = a0 + q, *a2 = a1 + q, *a3 = a2 + q;
+                for(int j = 0; j < q; j++) {
+                    mint w1 = irt[2 * q + j], w2 = irt[q + j];
+                    mint b1 = a1[j] * w2, b2 = a2[j] * w1, b3 = a3[j] * (w1 * w2);
+                    mint x0 = a0[j] + b1, x1 = a0[j] - b1;
+                    mint y0 = b2 + b3, y1 = (b2 - b3) * I;
+                    a0[j] = x0 + y0;
+                    a2[j] = x0 - y0;
+                    a1[j] = x1 + y1;
+                    a3[j] = x1 - y1;
+                }
+            }
+        }
+        
+        if(odd) {
+            int h = n / 2;
+            for(int j = 0; j < h; j++) {
+                mint u = a[j], v = a[j + h] * irt[h + j];
+                a[j] = u + v;
+                a[j + h] = u - v;
+            }
+        }
+        
+        mint invN = mint(n).inv();
+        for(int i = 0; i < n; i++) a[i] *= invN;
+    }
+    
+    // Product of two polynomials (coefficient vectors, lowest degree first)
+    static vector<mint> multiply(vector<mint> a, vector<mint> b) {
+        if(a.empty() || b.empty()) return {};
+        int need = a.size() + b.size() - 1;
+        
+        if(min(a.size(), b.size()) <= 32) {  // Schoolbook is faster for short inputs
+            vector<mint> c(need);
+            for(size_t i = 0; i < a.size(); i++) {
+                for(size_t j = 0; j < b.size(); j++) c[i + j] += a[i] * b[j];
+            }
+            return c;
+        }
+        
+        int n = 1;
+        while(n < need) n <<= 1;
+        assert(__builtin_ctz(n) <= MAX_LOG);
+        
+        a.resize(n);
+        b.resize(n);
+        forward(a.data(), n);
+        forward(b.data(), n);
+        batchMul(a.data(), b.data(), a.data(), n);
+        inverse(a.data(), n);
+        a.resize(need);
+        return a;
+    }
+};
+
+// Convolution mod any modulus < 2^31: multiply mod three NTT primes and
+// rebuild each coefficient (< n * mod^2 < 2^86) with Garner's CRT.
+const uint32_t NTT_P1 = 998244353, NTT_P2 = 167772161, NTT_P3 = 469762049;
+
+template<uint32_t P>
+vector<ModInt<P>> convolveModPrime(const vector<uint32_t> &a, const vector<uint32_t> &b) {
+    return NTT<P>::multiply(vector<ModInt<P>>(a.begin(), a.end()),
+                            vector<ModInt<P>>(b.begin(), b.end()));
+}
+
+vector<uint32_t> convolutionMod(const vector<uint32_t> &a, const vector<uint32_t> &b, uint32_t mod) {
+    vector<ModInt<NTT_P1>> c1 = convolveModPrime<NTT_P1>(a, b);
+    vector<ModInt<NTT_P2>> c2 = convolveModPrime<NTT_P2>(a, b);
+    vector<ModInt<NTT_P3>> c3 = convolveModPrime<NTT_P3>(a, b);
+    
+    const ModInt<NTT_P2> inv12 = ModInt<NTT_P2>(NTT_P1).inv();
+    const ModInt<NTT_P3> inv123 = ModInt<NTT_P3>((uint64_t)NTT_P1 * NTT_P2).inv();
+    const uint64_t p1p2 = (uint64_t)NTT_P1 * NTT_P2;
+    
+    vector<uint32_t> result(c1.size());
+    if(mod == 1) return result;
+    Barrett bt = barrettFor(mod);
+    for(size_t i = 0; i < c1.size(); i++) {
+        // x = r1 + p1 * x2 + p1 * p2 * x3
+        uint64_t r1 = c1[i].val();
+        uint64_t x2 = ((ModInt<NTT_P2>(c2[i].val()) - ModInt<NTT_P2>(r1)) * inv12).val();
+        uint64_t low = r1 + NTT_P1 * x2;  // < p1 * p2
+        uint64_t x3 = ((ModInt<NTT_P3>(c3[i].val()) - ModInt<NTT_P3>(low)) * inv123).val();
+        result[i] = bt.reduce(bt.reduce(low) + (uint64_t)bt.reduce(p1p2) * x3);
+    }
+    return result;
+}
+
+// Power series (truncated to n terms) mod an NTT prime, built on NTT<M>::multiply
+template<uint32_t M>
+using Poly = vector<ModInt<M>>;
+
+// 1 / a mod x^n, needs a[0] != 0 - Newton: b <- b (2 - a b)
+template<uint32_t M>
+Poly<M> polyInv(const Poly<M> &a, int n) {
+    Poly<M> b = {a[0].inv()};
+    for(int k = 1; k < n; k *= 2) {
+        Poly<M> head(a.begin(), a.begin() + min<size_t>(a.size(), 2 * k));
+        Poly<M> t = NTT<M>::multiply(NTT<M>::multiply(b, b), head);
+        t.resize(2 * k);
+        b.resize(2 * k);
+        for(int i = 0; i < 2 * k; i++) b[i] = b[i] + b[i] - t[i];
+    }
+    b.resize(n);
+    return b;
+}
+
+// ln(a) mod x^n, needs a[0] = 1 - integral of a' / a
+template<uint32_t M>
+Poly<M> polyLog(const Poly<M> &a, int n) {
+    if(n <= 1) return Poly<M>(n);
+    Poly<M> deriv(max<size_t>(a.size(), 2) - 1);
+    for(size_t i = 1; i < a.size(); i++) deriv[i - 1] = a[i] * ModInt<M>(i);
+    
+    Poly<M> q = NTT<M>::multiply(deriv, polyInv(a, n));
+    // Inverses of 1..n-1 for the integral: inv[i] = -(M / i) * inv[M % i]
+    Poly<M> inv(n);
+    inv[1] = 1;
+    for(int i = 2; i < n; i++) inv[i] = -ModInt<M>(M / i) * inv[M % i];
+    
+    Poly<M> result(n);
+    for(int i = 1; i < n && i - 1 < (int)q.size(); i++) result[i] = q[i - 1] * inv[i];
+    return result;
+}
+
+// exp(a) mod x^n, needs a[0] = 0 - Newton: b <- b (1 - ln b + a)
+template<uint32_t M>
+Poly<M> polyExp(const Poly<M> &a, int n) {
+    Poly<M> b = {1};
+    for(int k = 1; k < n; k *= 2) {
+        Poly<M> t = polyLog(b, 2 * k);
+        for(int i = 0; i < 2 * k; i++) {
+            t[i] = (i < (int)a.size() ? a[i] : ModInt<M>(0)) - t[i];
+        }
+        t[0] += 1;
+        b = NTT<M>::multiply(b, t);
+        b.resize(2 * k);
+    }
+    b.resize(n);
+    return b;
+}
+
+// ===== 16. SUBLINEAR PRIME COUNTING AND MULTIPLICATIVE PREFIX SUMS =====
+// pi(n) and sum of f(i) for multiplicative f up to n ~ 10^12 without sieving to n.
+// Only the O(sqrt n) distinct values v = n / i matter. Lucy_Hedgehog's DP
+// removes one prime at a time from "count / sum of numbers <= v":
+//   S(v, p) = S(v, p - 1) - p^k * (S(v / p, p - 1) - S(p - 1, p - 1))
+// in O(n^(3/4) / log n) time and O(sqrt n) memory. Min_25's second phase then
+// adds composites back, for any f with f(p) = c0 + c1 * p (phi, mu, d, sigma...).
+
+struct LucyTables {
+    long long n, sq;
+    vector<long long> vals;     // Every distinct n / i, decreasing
+    vector<long long> cnt;      // pi(v)
+    vector<__int128> sum;       // Sum of primes <= v
+    vector<int> idxSmall, idxLarge;
+    vector<int> primes;         // Primes <= sqrt(n)
+    
+    LucyTables(long long n) : n(n) {
+        sq = sqrtl((long double)n);
+        while(sq * sq > n) sq--;
+        while((sq + 1) * (sq + 1) <= n) sq++;
+        
+        idxSmall.assign(sq + 2, 0);
+        idxLarge.assign(sq + 2, 0);
+        for(long long i = 1; i <= n; i = n / (n / i) + 1) {
+            long long v = n / i;
+            (v <= sq ? idxSmall[v] : idxLarge[n / v]) = vals.size();
+            vals.push_back(v);
+            cnt.push_back(v - 1);
+            sum.push_back((__int128)v * (v + 1) / 2 - 1);
+        }
+        
+        primes = getPrimes(sq);
+        for(int p : primes) {
+            long long pp = (long long)p * p;
+            long long cntBelow = cnt[idx(p - 1)];
+            __int128 sumBelow = sum[idx(p - 1)];
+            for(size_t i = 0; i < vals.size() && vals[i] >= pp; i++) {
+                int j = idx(vals[i] / p);
+                cnt[i] -= cnt[j] - cntBelow;
+                sum[i] -= p * (sum[j] - sumBelow);
+            }
+        }
+    }
+    
+    // Position of v = n / i in vals
+    int idx(long long v) const {
+        return v <= sq ? idxSmall[v] : idxLarge[n / v];
+    }
+};
+
+// pi(n) - O(n^(3/4) / log n)
+long long primeCount(long long n) {
+    if(n < 2) return 0;
+    LucyTables t(n);
+    return t.cnt[0];
+}
+
+// Min_25 second phase: sum of f(i) over 2 <= i <= x whose smallest prime
+// factor is >= primes[j]. fpe(p, e) returns f(p^e).
+template<class PowerF>
+__int128 min25Sum(const LucyTables &t, long long c0, long long c1, PowerF &fpe,
+                  const vector<__int128> &primePrefix, long long x, size_t j) {
+    if(x < 2 || (j > 0 && t.primes[j - 1] >= x)) return 0;
+    
+    // Primes in (primes[j - 1], x]
+    int i = t.idx(x);
+    __int128 result = c0 * (__int128)t.cnt[i] + c1 * t.sum[i] - primePrefix[j];
+    
+    for(size_t k = j; k < t.primes.size() && (long long)t.primes[k] * t.primes[k] <= x; k++) {
+        long long p = t.primes[k];
+        long long pe = p;
+        for(int e = 1; pe * p <= x; e++, pe *= p) {
+            result += fpe(p, e) * min25Sum(t, c0, c1, fpe, primePrefix, x / pe, k + 1)
+                      + fpe(p, e + 1);
+        }
+    }
+    return result;
+}
+
+// Sum of f(1..n) for multiplicative f with f(p) = c0 + c1 * p
+template<class PowerF>
+__int128 multiplicativePrefixSum(long long n, long long c0, long long c1, PowerF fpe) {
+    if(n < 1) return 0;
+    LucyTables t(n);
+    
+    // primePrefix[j] = f(p) summed over the first j primes
+    vector<__int128> primePrefix(t.primes.size() + 1, 0);
+    for(size_t j = 0; j < t.primes.size(); j++) {
+        primePrefix[j + 1] = primePrefix[j] + c0 + (__int128)c1 * t.primes[j];
+    }
+    
+    return 1 + min25Sum(t, c0, c1, fpe, primePrefix, n, 0);
+}
+
+// Sum of phi(1..n): phi(p^e) = p^e - p^(e-1), phi(p) = p - 1
+__int128 totientSum(long long n) {
+    auto phiPower = [](long long p, int e) {
+        __int128 pe = 1;
+        for(int i = 1; i < e; i++) pe *= p;
+        return pe * (p - 1);
+    };
+    return multiplicativePrefixSum(n, -1, 1, phiPower);
+}
+
+string int128ToString(__int128 x) {
+    if(x == 0) return "0";
+    bool negative = x < 0;
+    string s;
+    while(x != 0) {
+        int digit = (int)(x % 10);
+        s += char('0' + (negative ? -digit : digit));
+        x /= 10;
+    }
+    if(negative) s += '-';
+    reverse(s.begin(), s.end());
+    return s;
+}
+
+// ===== 17. DISCRETE LOGARITHM AND MODULAR SQUARE ROOTS =====
+// a^x ≡ b and x^2 ≡ a modulo a prime p < 2^62. Exponentiations go through
+// modPow; the BSGS inner loops multiply in Montgomery form.
+
+// Open-addressing map residue -> smallest exponent (linear probing).
+// Capacity is a power of two >= 2 * size, so probe runs stay short.
+struct ResidueTable {
+    static constexpr uint64_t EMPTY = ~0ULL;  // Residues are < p, never all ones
+    vector<uint64_t> keys;
+    vector<uint32_t> vals;
+    uint64_t mask;
+    int shift;
+    
+    ResidueTable(size_t size) {
+        size_t cap = 2;
+        while(cap < 2 * size) cap <<= 1;
+        keys.assign(cap, EMPTY);
+        vals.assign(cap, 0);
+        mask = cap - 1;
+        shift = 64 - __builtin_ctzll(cap);
+    }
+    
+    size_t slot(uint64_t key) const { return (key * 0x9E3779B97F4A7C15ULL) >> shift; }
+    
+    // Keeps the first value stored for a key
+    void insert(uint64_t key, uint32_t val) {
+        size_t i = slot(key);
+        while(keys[i] != EMPTY) {
+            if(keys[i] == key) return;
+            i = (i + 1) & mask;
+        }
+        keys[i] = key;
+        vals[i] = val;
+    }
+    
+    long long find(uint64_t key) const {
+        for(size_t i = slot(key); keys[i] != EMPTY; i = (i + 1) & mask) {
+            if(keys[i] == key) return vals[i];
+        }
+        return -1;
+    }
+};
+
+// Baby-step giant-step for a^x ≡ b (mod p), p odd, given a^order ≡ 1.
+// The m = ceil(sqrt(order)) baby steps a^j are hashed once; every solve()
+// then walks at most m giant steps b * a^(-m i) - O(sqrt(order)) each.
+struct BabyStepGiantStep {
+    Montgomery64 mg;
+    uint64_t order, m, giant;  // giant = a^(-m) in Montgomery form
+    ResidueTable table;
+    
+    static uint64_t steps(uint64_t order) {
+        uint64_t m = sqrtl((long double)order);
+        while(m * m < order) m++;
+        return max<uint64_t>(m, 1);
+    }
+    
+    BabyStepGiantStep(long long a, long long p, uint64_t order)
+        : mg(p), order(order), m(steps(order)), table(m) {
+        uint64_t step = mg.to(a), cur = mg.to(1);
+        for(uint64_t j = 0; j < m; j++) {
+            table.insert(cur, j);
+            cur = mg.mul(cur, step);
+        }
+        giant = mg.to(modPow(a, (order - m % order) % order, p));
+    }
+    
+    // Smallest x in [0, order) with a^x ≡ b, or -1
+    long long solve(long long b) const {
+        uint64_t cur = mg.to(b);
+        for(uint64_t i = 0; i * m < order; i++) {
+            long long j = table.find(cur);
+            if(j >= 0 && i * m + j < order) return i * m + j;
+            cur = mg.mul(cur, giant);
+        }
+        return -1;
+    }
+};
+
+// Smallest x >= 0 with a^x ≡ b (mod p), or -1. Pohlig-Hellman splits the
+// order of a into prime powers q^e and finds x mod q^e one base-q digit at a
+// time with a BSGS over the order-q subgroup: O(sum e * sqrt(q)) steps, so
+// smooth p - 1 is fast and a prime (p - 1) / 2 costs one sqrt(p) BSGS.
+long long discreteLog(long long a, long long b, long long p) {
+    a %= p; if(a < 0) a += p;
+    b %= p; if(b < 0) b += p;
+    if(a == 0) return b == 1 ? 0 : (b == 0 ? 1 : -1);
+    if(b == 0) return -1;
+    if(p == 2) return 0;
+    
+    // Order of a in (Z/p)*
+    vector<pair<uint64_t, int>> factors = primeFactors64(p - 1);
+    long long ord = p - 1;
+    for(auto &f : factors) {
+        long long q = f.first;
+        while(ord % q == 0 && modPow(a, ord / q, p) == 1) ord /= q;
+    }
+    if(modPow(b, ord, p) != 1) return -1;  // b is not a power of a
+    
+    long long x = 0, mod = 1;
+    for(auto &f : factors) {
+        long long q = f.first, qe = 1;
+        int e = 0;
+        while(ord / qe % q == 0) {
+            qe *= q;
+            e++;
+        }
+        if(e == 0) continue;
+        
+        // g has order q^e; gamma = g^(q^(e-1)) has order q
+        long long g = modPow(a, ord / qe, p), h = modPow(b, ord / qe, p);
+        long long gInv = modPow(g, qe - 1, p);
+        BabyStepGiantStep bsgs(modPow(g, qe / q, p), p, q);
+        
+        long long xq = 0, qk = 1;
+        for(int k = 0; k < e; k++) {
+            // (g^-xq * h)^(q^(e-1-k)) = gamma^(digit k)
+            long long t = (u128)modPow(gInv, xq, p) * h % p;
+            long long digit = bsgs.solve(modPow(t, qe / qk / q, p));
+            if(digit < 0) return -1;
+            xq += digit * qk;
+            qk *= q;
+        }
+        crtMerge(x, mod, xq, qe);
+    }
+    return x;
+}
+
+// Euler's criterion: 1 if a is a nonzero square mod p, -1 if not, 0 if p | a
+int legendreSymbol(long long a, long long p) {
+    a %= p; if(a < 0) a += p;
+    if(a == 0) return 0;
+    return modPow(a, (p - 1) / 2, p) == 1 ? 1 : -1;
+}
+
+// Tonelli-Shanks for a quadratic residue a mod odd prime p.
+// p - 1 = q * 2^s: O(log p + s^2) multiplications.
+long long tonelliShanks(long long a, long long p) {
+    long long q = p - 1;
+    int s = 0;
+    while(q % 2 == 0) {
+        q /= 2;
+        s++;
+    }
+    long long z = 2;
+    while(legendreSymbol(z, p) != -1) z++;
+    
+    auto mul = [p](long long x, long long y) { return (long long)((u128)x * y % p); };
+    long long c = modPow(z, q, p), t = modPow(a, q, p), r = modPow(a, (q + 1) / 2, p);
+    int m = s;
+    while(t != 1) {
+        // Least i with t^(2^i) = 1
+        int i = 0;
+        for(long long tt = t; tt != 1; tt = mul(tt, tt)) i++;
+        long long b = c;
+        for(int j = 0; j < m - i - 1; j++) b = mul(b, b);
+        r = mul(r, b);
+        c = mul(b, b);
+        t = mul(t, c);
+        m = i;
+    }
+    return r;
+}
+
+// Cipolla for a quadratic residue a mod odd prime p: pick w with w^2 - a a
+// non-residue and raise w + sqrt(w^2 - a) to (p + 1) / 2 in F_p^2 -
+// O(log p) multiplications whatever the power of two in p - 1.
+long long cipolla(long long a, long long p) {
+    auto mul = [p](long long x, long long y) { return (long long)((u128)x * y % p); };
+    long long w = 0, d;
+    do {
+        w++;
+        d = ((u128)w * w + p - a) % p;
+    } while(legendreSymbol(d, p) != -1);
+    
+    // (x0 + x1 * sqrt(d)) * (y0 + y1 * sqrt(d))
+    long long r0 = 1, r1 = 0, b0 = w, b1 = 1;
+    for(long long e = (p + 1) / 2; e > 0; e >>= 1) {
+        if(e & 1) {
+            long long t0 = (mul(r0, b0) + mul(mul(r1, b1), d)) % p;
+            r1 = (mul(r0, b1) + mul(r1, b0)) % p;
+            r0 = t0;
+        }
+        long long t0 = (mul(b0, b0) + mul(mul(b1, b1), d)) % p;
+        b1 = mul(2 * b0 % p, b1);
+        b0 = t0;
+    }
+    return r0;
+}
+
+// Smaller square root of a mod prime p, or -1 if a is a non-residue.
+// Tonelli-Shanks unless p - 1 has so many factors of two that its s^2
+// term outweighs Cipolla's ~3x costlier F_p^2 multiplications.
+long long sqrtMod(long long a, long long p) {
+    a %= p; if(a < 0) a += p;
+    if(a == 0 || p == 2) return a;
+    if(legendreSymbol(a, p) != 1) return -1;
+    
+    int s = __builtin_ctzll(p - 1), bits = 64 - __builtin_clzll(p);
+    long long r = s * s > 2 * bits ? cipolla(a, p) : tonelliShanks(a, p);
+    return min(r, p - r);
+}
+
+// ===== MAIN FUNCTION =====
+int main() {
+    // Prime check
+    cout << "Is 17 prime? " << isPrime(17) << endl;
+    
+    // Sieve
+    vector<bool> primes = sieveOfEratosthenes(50);
+    cout << "Primes up to 50: ";
+    for(int i = 2; i <= 50; i++) {
+        if(primes[i]) cout << i << " ";
+    }
+    cout << endl;
+    
+    // Segmented wheel sieve
+    cout << "Primes up to 10^9: " << countPrimes(1000000000) << endl;
+    cout << "getPrimes(50) size: " << getPrimes(50).size() << endl;
+    cout << "pi(10^10) via Lucy_Hedgehog: " << primeCount(10000000000LL) << endl;
+    
+    // GCD and LCM
+    cout << "GCD(48, 18) = " << gcd(48, 18) << endl;
+    cout << "LCM(48, 18) = " << lcm(48, 18) << endl;
+    
+    // Prime factors
+    vector<pair<int, int>> factors = primeFactors(60);
+    cout << "Prime factors of 60: ";
+    for(auto &f : factors) {
+        cout << f.first << "^" << f.second << " ";
+    }
+    cout << endl;
+    
+    // Modular exponentiation
+    cout << "2^10 mod 1000 = " << modPow(2, 10, 1000) << endl;
+    
+    // ModInt: Montgomery form with a compile-time modulus
+    typedef ModInt<MOD> mint;
+    mint a = 123456789;
+    cout << "a^-1 * a = " << (a.inv() * a).val() << endl;
+    benchmarkModArithmetic(1 << 20);
+    
+    // Discrete log and square roots mod the 61-bit Mersenne prime
+    long long mersenne61 = (1LL << 61) - 1;
+    long long x = discreteLog(37, modPow(37, 123456789012345LL, mersenne61), mersenne61);
+    cout << "log_37(37^123456789012345) mod 2^61 - 1 = " << x << endl;
+    long long root = sqrtMod(2, MOD);
+    cout << "sqrt(2) mod " << MOD << " = " << root
+         << " (check: " << root * root % MOD << ")" << endl;
+    
+    // Combinations
+    cout << "C(5, 2) = " << nCr(5, 2) << endl;
+    
+    // CRT with non-coprime moduli: x ≡ 2 (mod 6), x ≡ 8 (mod 10)
+    pair<long long, long long> crt = chineseRemainder({2, 8}, {6, 10});
+    cout << "CRT: x = " << crt.first << " (mod " << crt.second << ")" << endl;
+    
+    // Binomials mod a composite modulus
+    BinomialMod binom(1000000);
+    cout << "C(10^18, 5 * 10^17) mod 10^6 = " << binom.nCr(1000000000000000000LL, 500000000000000000LL) << endl;
+    Combinatorics<> comb(1000);
+    cout << "C(1000, 500) = " << comb.nCr(1000, 500).val()
+         << ", Catalan(10) = " << comb.catalan(10).val() << endl;
+    
+    // Euler Totient
+    cout << "φ(10) = " << eulerTotient(10) << endl;
+    
+    // Min_25 totient sum, cross-checked with the sieve for small n
+    vector<int> phiTable = eulerTotientSieve(100000);
+    long long phiSum = 0;
+    for(int i = 1; i <= 100000; i++) phiSum += phiTable[i];
+    cout << "Sum of φ(1..10^5): " << int128ToString(totientSum(100000))
+         << " (sieve: " << phiSum << ")" << endl;
+    cout << "Sum of φ(1..10^11): " << int128ToString(totientSum(100000000000LL)) << endl;
+    
+    // Linear sieve: batch queries answered from tables
+    LinearSieve sieve(100);
+    vector<int> queries = {12, 36, 97, 100};
+    vector<int> divs = countDivisors(queries, sieve);
+    vector<int> phis = eulerTotient(queries, sieve);
+    for(size_t i = 0; i < queries.size(); i++) {
+        cout << "d(" << queries[i] << ") = " << divs[i]
+             << ", φ(" << queries[i] << ") = " << phis[i] << endl;
+    }
+    
+    // 64-bit primality and factorization
+    cout << "Is 2^61 - 1 prime? " << isPrime64((1ULL << 61) - 1) << endl;
+    cout << "Prime factors of 2^62 - 1: ";
+    for(auto &f : primeFactors64((1ULL << 62) - 1)) {
+        cout << f.first << "^" << f.second << " ";
+    }
+    cout << endl;
+    benchmarkFactorization(1000);
+    
+    // Power engine
+    benchmarkPowers(1 << 18);
+    
+    // Fibonacci
+    cout << "F(10) = " << fibonacci(10) << endl;
+    cout << "F(90) mod 10007 = " << fibonacciFast<10007>(90)
+         << " (matrixPower: " << fibonacci(90, 10007) << ")" << endl;
+    benchmarkMatrixPower();
+    
+    // Recurrence found from samples: Fibonacci again
+    vector<long long> fibSamples = {0, 1, 1, 2, 3, 5, 8, 13};
+    cout << "F(10^18) via Berlekamp-Massey + Kitamasa = "
+         << nthTermFromSamples(fibSamples, 1000000000000000000ULL).val()
+         << " (matrix: " << fibonacci(1000000000000000000LL) << ")" << endl;
+    
+    // NTT: (1 + 2x + 3x^2)(4 + 5x) and exp(x) = sum x^k / k!
+    vector<uint32_t> product = convolutionMod({1, 2, 3}, {4, 5}, MOD);
+    cout << "(1 + 2x + 3x^2)(4 + 5x) = ";
+    for(uint32_t c : product) cout << c << " ";
+    cout << endl;
+    Poly<NTT_P1> e = polyExp(Poly<NTT_P1>{0, 1}, 6);
+    cout << "5! * [x^5] exp(x) = " << (e[5] * ModInt<NTT_P1>(120)).val() << endl;
     
     return 0;
 }
@@ -8,15 +8,31 @@
 #include <iostream>
 #include <vector>
 #include <string>
+#include <string_view>
 #include <algorithm>
 #include <map>
+#include <cstdint>
+#include <cassert>
+#include <climits>
+#include <cstring>
+#include <thread>
+#include <random>
+#include <chrono>
+#include <queue>
+#include <tuple>
+#include <fstream>
+#include <sstream>
+#include <cstdio>
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#endif
 using namespace std;
 
 // ===== 1. KMP ALGORITHM (Knuth-Morris-Pratt) =====
 // Pattern matching in O(n + m) time
 
 // Build prefix function (LPS array)
-vector<int> buildLPS(string pattern) {
+vector<int> buildLPS(string_view pattern) {
     int m = pattern.length();
     vector<int> lps(m, 0);
     int len = 0;
@@ -40,42 +56,53 @@ vector<int> buildLPS(string pattern) {
     return lps;
 }
 
-// KMP search - returns all occurrences
-vector<int> KMPSearch(string text, string pattern) {
-    vector<int> result;
-    int n = text.length();
-    int m = pattern.length();
+// Streaming KMP: the text arrives in chunks (pipe, mmap'ed file, socket...)
+// and only the pattern, its LPS array and the matched length are kept -
+// O(m) memory however long the text is. onMatch(start) gets stream offsets.
+class KMPMatcher {
+    string pattern;
+    vector<int> lps;
+    int matched = 0;        // Pattern chars matched before the next text byte
+    long long offset = 0;   // Stream offset of the next chunk
     
-    vector<int> lps = buildLPS(pattern);
+public:
+    KMPMatcher(string_view pattern) : pattern(pattern), lps(buildLPS(pattern)) {}
     
-    int i = 0;  // Index for text
-    int j = 0;  // Index for pattern
+    void reset() {
+        matched = 0;
+        offset = 0;
+    }
     
-    while(i < n) {
-        if(pattern[j] == text[i]) {
-            i++;
-            j++;
-        }
-        
-        if(j == m) {
-            result.push_back(i - j);  // Pattern found at index i - j
-            j = lps[j - 1];
-        } else if(i < n && pattern[j] != text[i]) {
-            if(j != 0) {
+    template<class F>
+    void feed(string_view chunk, F &&onMatch) {
+        int m = pattern.size();
+        if(m == 0) return;
+        int j = matched;
+        for(size_t i = 0; i < chunk.size(); i++) {
+            while(j > 0 && chunk[i] != pattern[j]) j = lps[j - 1];
+            if(chunk[i] == pattern[j]) j++;
+            if(j == m) {
+                onMatch(offset + (long long)i + 1 - m);
                 j = lps[j - 1];
-            } else {
-                i++;
             }
         }
+        matched = j;
+        offset += chunk.size();
     }
-    
+};
+
+// KMP search - returns all occurrences (empty pattern: none)
+vector<int> KMPSearch(string_view text, string_view pattern) {
+    vector<int> result;
+    KMPMatcher matcher(pattern);
+    matcher.feed(text, [&](long long pos) { result.push_back(pos); });
     return result;
 }
 
 // ===== 2. Z-ALGORITHM =====
 // Find all occurrences of pattern in text
 
-vector<int> buildZArray(string s) {
+vector<int> buildZArray(string_view s) {
     int n = s.length();
     vector<int> z(n, 0);
     int l = 0, r = 0;
@@ -98,21 +125,79 @@ vector<int> buildZArray(string s) {
     return z;
 }
 
-vector<int> ZSearch(string text, string pattern) {
-    string combined = pattern + "$" + text;
-    vector<int> z = buildZArray(combined);
-    vector<int> result;
+// Streaming Z matcher: instead of Z over pattern + "$" + text, compute
+// ext[i] = LCP(text[i..], pattern) on the fly. Invariant: text[i..r) equals
+// pattern[0..r - i), and [l, r) is the box the Z array of the pattern is
+// read against. Only pattern bytes are ever re-read, so no text is buffered:
+// O(m) memory, O(n + m) time.
+class ZMatcher {
+    string pattern;
+    vector<int> z;
+    long long i = 0, l = 0, r = 0;  // Stream positions; r = next byte to arrive
     
-    int m = pattern.length();
-    for(int i = m + 1; i < combined.length(); i++) {
-        if(z[i] == m) {
-            result.push_back(i - m - 1);
-        }
+    // ext[i] is settled at r - i; move i to the next position still alive
+    void advance() {
+        l = i;
+        i++;
+        while(i < r && z[i - l] < r - i) i++;
     }
     
+public:
+    ZMatcher(string_view pattern) : pattern(pattern), z(buildZArray(pattern)) {}
+    
+    void reset() { i = l = r = 0; }
+    
+    template<class F>
+    void feed(string_view chunk, F &&onMatch) {
+        long long m = pattern.size();
+        if(m == 0) return;
+        for(char c : chunk) {
+            while(true) {
+                if(i == r) {
+                    // Nothing pending: c either starts a match or is skipped
+                    if(c != pattern[0]) {
+                        i = ++r;
+                        break;
+                    }
+                    r++;
+                } else if(c == pattern[r - i]) {
+                    r++;
+                } else {
+                    advance();  // Mismatch ends ext[i]; retry c against the next i
+                    continue;
+                }
+                if(r - i == m) {
+                    onMatch(i);
+                    advance();
+                }
+                break;
+            }
+        }
+    }
+};
+
+// Z search - returns all occurrences (empty pattern: none)
+vector<int> ZSearch(string_view text, string_view pattern) {
+    vector<int> result;
+    ZMatcher matcher(pattern);
+    matcher.feed(text, [&](long long pos) { result.push_back(pos); });
     return result;
 }
 
+// Feed a stream (file, pipe, cin) to a matcher chunk by chunk - memory is
+// the chunk plus the matcher state. Works for KMPMatcher, ZMatcher and
+// AhoCorasick; returns the number of bytes read.
+template<class Matcher, class F>
+long long scanStream(istream &in, Matcher &matcher, F &&onMatch, size_t chunkSize = 1 << 16) {
+    vector<char> buf(chunkSize);
+    long long total = 0;
+    while(in.read(buf.data(), buf.size()) || in.gcount() > 0) {
+        matcher.feed(string_view(buf.data(), in.gcount()), onMatch);
+        total += in.gcount();
+    }
+    return total;
+}
+
 // ===== 3. ROLLING HASH (Rabin-Karp) =====
 // String matching using hash - average O(n + m)
 
@@ -120,7 +205,70 @@ const int BASE = 256;
 const int MOD1 = 1000000007;
 const int MOD2 = 1000000009;
 
+// ModInt<M>: arithmetic mod a compile-time odd M < 2^31 in Montgomery form
+// (x * 2^32 mod M), so a multiply is two integer multiplies and a shift.
+// Full version with runtime-modulus and batch variants: 05_Advanced/01_Number_Theory.cpp
+template<uint32_t M>
+struct ModInt {
+    static_assert(M % 2 == 1 && M < (1u << 31), "Montgomery needs an odd modulus < 2^31");
+    
+    static constexpr uint32_t computeNegInv() {
+        uint32_t inv = M;
+        for(int i = 0; i < 4; i++) inv *= 2 - M * inv;
+        return -inv;
+    }
+    static constexpr uint32_t NEG_INV = computeNegInv();         // -M^-1 mod 2^32
+    static constexpr uint32_t R2 = (uint32_t)(-(uint64_t)M % M);  // 2^64 mod M
+    
+    static uint32_t reduce(uint64_t x) {
+        uint32_t q = (uint32_t)x * NEG_INV;
+        uint32_t r = (x + (uint64_t)q * M) >> 32;
+        return r >= M ? r - M : r;
+    }
+    
+    uint32_t v;
+    
+    ModInt() : v(0) {}
+    ModInt(long long x) {
+        x %= (long long)M;
+        if(x < 0) x += M;
+        v = reduce((uint64_t)x * R2);
+    }
+    
+    uint32_t val() const { return reduce(v); }
+    
+    ModInt& operator+=(const ModInt &o) { v += o.v; if(v >= M) v -= M; return *this; }
+    ModInt& operator-=(const ModInt &o) { v = v >= o.v ? v - o.v : v + M - o.v; return *this; }
+    ModInt& operator*=(const ModInt &o) { v = reduce((uint64_t)v * o.v); return *this; }
+    ModInt& operator/=(const ModInt &o) { return *this *= o.inv(); }
+    
+    friend ModInt operator+(ModInt a, const ModInt &b) { return a += b; }
+    friend ModInt operator-(ModInt a, const ModInt &b) { return a -= b; }
+    friend ModInt operator*(ModInt a, const ModInt &b) { return a *= b; }
+    friend ModInt operator/(ModInt a, const ModInt &b) { return a /= b; }
+    bool operator==(const ModInt &o) const { return v == o.v; }
+    bool operator!=(const ModInt &o) const { return v != o.v; }
+    
+    ModInt pow(long long exp) const {
+        ModInt result = 1, base = *this;
+        while(exp > 0) {
+            if(exp & 1) result *= base;
+            base *= base;
+            exp >>= 1;
+        }
+        return result;
+    }
+    
+    ModInt inv() const { return pow(M - 2); }  // M must be prime
+};
+
+typedef ModInt<MOD1> Hash1;
+typedef ModInt<MOD2> Hash2;
+
 long long modPow(long long base, long long exp, long long mod) {
+    if(mod == MOD1) return Hash1(base).pow(exp).val();
+    if(mod == MOD2) return Hash2(base).pow(exp).val();
+    
     long long result = 1;
     base %= mod;
     while(exp > 0) {
@@ -131,37 +279,42 @@ long long modPow(long long base, long long exp, long long mod) {
     return result;
 }
 
-long long computeHash(string s, long long mod, long long base) {
-    long long hash = 0;
+// Polynomial hash of s in ModInt arithmetic
+template<class Mint>
+Mint computeHash(string_view s, Mint base) {
+    Mint hash = 0;
     for(char c : s) {
-        hash = (hash * base + c) % mod;
+        hash = hash * base + Mint(c);
     }
     return hash;
 }
 
-vector<int> rabinKarp(string text, string pattern) {
+vector<int> rabinKarp(string_view text, string_view pattern) {
     vector<int> result;
     int n = text.length();
     int m = pattern.length();
     
     if(m > n) return result;
     
-    long long patternHash1 = computeHash(pattern, MOD1, BASE);
-    long long patternHash2 = computeHash(pattern, MOD2, BASE);
+    Hash1 base1 = BASE;
+    Hash2 base2 = BASE;
+    Hash1 patternHash1 = computeHash(pattern, base1);
+    Hash2 patternHash2 = computeHash(pattern, base2);
     
-    long long textHash1 = 0, textHash2 = 0;
-    long long power1 = modPow(BASE, m - 1, MOD1);
-    long long power2 = modPow(BASE, m - 1, MOD2);
+    Hash1 textHash1 = 0;
+    Hash2 textHash2 = 0;
+    Hash1 power1 = base1.pow(m - 1);
+    Hash2 power2 = base2.pow(m - 1);
     
     // Compute hash of first window
     for(int i = 0; i < m; i++) {
-        textHash1 = (textHash1 * BASE + text[i]) % MOD1;
-        textHash2 = (textHash2 * BASE + text[i]) % MOD2;
+        textHash1 = textHash1 * base1 + Hash1(text[i]);
+        textHash2 = textHash2 * base2 + Hash2(text[i]);
     }
     
     // Check first window
     if(textHash1 == patternHash1 && textHash2 == patternHash2) {
-        if(text.substr(0, m) == pattern) {
+        if(text.compare(0, m, pattern) == 0) {
             result.push_back(0);
         }
     }
@@ -169,15 +322,12 @@ vector<int> rabinKarp(string text, string pattern) {
     // Slide window
     for(int i = m; i < n; i++) {
         // Remove leftmost character, add rightmost
-        textHash1 = ((textHash1 - text[i - m] * power1) % MOD1 + MOD1) % MOD1;
-        textHash1 = (textHash1 * BASE + text[i]) % MOD1;
-        
-        textHash2 = ((textHash2 - text[i - m] * power2) % MOD2 + MOD2) % MOD2;
-        textHash2 = (textHash2 * BASE + text[i]) % MOD2;
+        textHash1 = (textHash1 - Hash1(text[i - m]) * power1) * base1 + Hash1(text[i]);
+        textHash2 = (textHash2 - Hash2(text[i - m]) * power2) * base2 + Hash2(text[i]);
         
         if(textHash1 == patternHash1 && textHash2 == patternHash2) {
             // Verify to handle hash collisions
-            if(text.substr(i - m + 1, m) == pattern) {
+            if(text.compare(i - m + 1, m, pattern) == 0) {
                 result.push_back(i - m + 1);
             }
         }
@@ -186,86 +336,462 @@ vector<int> rabinKarp(string text, string pattern) {
     return result;
 }
 
-// ===== 4. LONGEST PALINDROMIC SUBSTRING =====
+// Prefix hashes mod the Mersenne prime 2^61 - 1 for O(1) substring hashes.
+// The modulus makes a mulmod one 64x64 multiply plus shift/add (no %), and
+// the base is random per process, so no fixed input can force collisions:
+// two different length-L strings collide with probability <= L / 2^61.
+const uint64_t MERSENNE61 = (1ULL << 61) - 1;
+
+uint64_t mulMod61(uint64_t a, uint64_t b) {
+    unsigned __int128 p = (unsigned __int128)a * b;
+    uint64_t r = (uint64_t)(p >> 61) + ((uint64_t)p & MERSENNE61);
+    return r >= MERSENNE61 ? r - MERSENNE61 : r;
+}
+
+struct PrefixHash {
+    vector<uint64_t> h, pw;  // h[i] = hash of s[0..i), pw[i] = base^i
+    
+    // Shared by every PrefixHash so hashes of different strings compare
+    static uint64_t base() {
+        static const uint64_t b = [] {
+            mt19937_64 rng(random_device{}() ^ chrono::steady_clock::now().time_since_epoch().count());
+            return (1ULL << 20) + rng() % (MERSENNE61 - (1ULL << 21));
+        }();
+        return b;
+    }
+    
+    PrefixHash(string_view s) : h(s.size() + 1, 0), pw(s.size() + 1, 1) {
+        uint64_t b = base();
+        for(size_t i = 0; i < s.size(); i++) {
+            h[i + 1] = mulMod61(h[i], b) + (unsigned char)s[i] + 1;
+            if(h[i + 1] >= MERSENNE61) h[i + 1] -= MERSENNE61;
+            pw[i + 1] = mulMod61(pw[i], b);
+        }
+    }
+    
+    int size() const { return h.size() - 1; }
+    
+    // Hash of s[l..r) - O(1)
+    uint64_t hash(int l, int r) const {
+        uint64_t x = h[r] + MERSENNE61 - mulMod61(h[l], pw[r - l]);
+        return x >= MERSENNE61 ? x - MERSENNE61 : x;
+    }
+};
+
+// a[i..i+len) == b[j..j+len), up to hash collisions - O(1)
+bool substringsEqual(const PrefixHash &a, int i, const PrefixHash &b, int j, int len) {
+    return a.hash(i, i + len) == b.hash(j, j + len);
+}
+
+// Longest common prefix of a[i..] and b[j..] by binary search - O(log n)
+int lcp(const PrefixHash &a, int i, const PrefixHash &b, int j) {
+    int lo = 0, hi = min(a.size() - i, b.size() - j);
+    while(lo < hi) {
+        int mid = (lo + hi + 1) / 2;
+        if(substringsEqual(a, i, b, j, mid)) lo = mid;
+        else hi = mid - 1;
+    }
+    return lo;
+}
+
+// ===== 4. PALINDROMES (MANACHER, EERTREE) =====
 // Manacher's Algorithm - O(n)
+// odd[i]  : s[i - k + 1 .. i + k - 1] is a palindrome for every k <= odd[i]
+// even[i] : s[i - k .. i + k - 1] is a palindrome for every k <= even[i]
+// Works on s directly - no "^#a#b#c#$" copy.
+struct Manacher {
+    vector<int> odd, even;
+    
+    Manacher(string_view s) : odd(s.size()), even(s.size()) {
+        int n = s.size();
+        for(int i = 0, l = 0, r = -1; i < n; i++) {
+            int k = i > r ? 1 : min(odd[l + r - i], r - i + 1);
+            while(i - k >= 0 && i + k < n && s[i - k] == s[i + k]) k++;
+            odd[i] = k--;
+            if(i + k > r) {
+                l = i - k;
+                r = i + k;
+            }
+        }
+        for(int i = 0, l = 0, r = -1; i < n; i++) {
+            int k = i > r ? 0 : min(even[l + r - i + 1], r - i + 1);
+            while(i - k - 1 >= 0 && i + k < n && s[i - k - 1] == s[i + k]) k++;
+            even[i] = k--;
+            if(i + k > r) {
+                l = i - k - 1;
+                r = i + k;
+            }
+        }
+    }
+    
+    // Is s[l..r) a palindrome? - O(1)
+    bool isPalindrome(int l, int r) const {
+        int len = r - l;
+        if(len <= 1) return true;
+        if(len % 2) return 2 * odd[(l + r) / 2] - 1 >= len;
+        return 2 * even[(l + r) / 2] >= len;
+    }
+};
 
-string longestPalindromicSubstring(string s) {
-    // Transform string: "abc" -> "^#a#b#c#$"
-    string transformed = "^";
-    for(char c : s) {
-        transformed += "#";
-        transformed += c;
+string longestPalindromicSubstring(const string &s) {
+    Manacher m(s);
+    int maxLen = 0, start = 0;
+    for(int i = 0; i < (int)s.size(); i++) {
+        if(2 * m.even[i] > maxLen) {
+            maxLen = 2 * m.even[i];
+            start = i - m.even[i];
+        }
+        if(2 * m.odd[i] - 1 > maxLen) {
+            maxLen = 2 * m.odd[i] - 1;
+            start = i - m.odd[i] + 1;
+        }
+    }
+    return s.substr(start, maxLen);
+}
+
+// Palindromic tree (eertree): one node per distinct palindrome, built online
+// in O(n) amortized. Node 0 is the imaginary root (len -1), node 1 the empty
+// string. link = longest proper palindromic suffix. Children are kept as
+// sibling lists, so memory is O(n) whatever the alphabet.
+// diff = len - len[link]; seriesLink skips the rest of a run of equal diffs.
+// The suffix palindromes of any prefix form O(log n) such runs.
+struct Eertree {
+    string s;
+    vector<int> len, link, diff, seriesLink;
+    vector<int> firstChild, sibling;
+    vector<char> edge;        // Character on the edge into the node
+    int last = 1;             // Longest palindromic suffix of s
+    
+    Eertree() {
+        newNode(-1);
+        newNode(0);
     }
-    transformed += "#$";
     
-    int n = transformed.length();
-    vector<int> p(n, 0);
-    int center = 0, right = 0;
+    int newNode(int length) {
+        len.push_back(length);
+        link.push_back(0);
+        diff.push_back(0);
+        seriesLink.push_back(0);
+        firstChild.push_back(-1);
+        sibling.push_back(-1);
+        edge.push_back(0);
+        return len.size() - 1;
+    }
     
-    for(int i = 1; i < n - 1; i++) {
-        int mirror = 2 * center - i;
-        
-        if(i < right) {
-            p[i] = min(right - i, p[mirror]);
+    int child(int v, char c) const {
+        for(int u = firstChild[v]; u != -1; u = sibling[u]) {
+            if(edge[u] == c) return u;
         }
-        
-        // Expand around center
-        while(transformed[i + (1 + p[i])] == transformed[i - (1 + p[i])]) {
-            p[i]++;
+        return -1;
+    }
+    
+    // Longest suffix palindrome of v that extends to cA...A c at position i
+    int extendable(int v, int i) const {
+        while(i - 1 - len[v] < 0 || s[i - 1 - len[v]] != s[i]) v = link[v];
+        return v;
+    }
+    
+    // Append c; returns the node of the new longest palindromic suffix
+    int add(char c) {
+        s += c;
+        int i = s.size() - 1;
+        int v = extendable(last, i);
+        int u = child(v, c);
+        if(u == -1) {
+            u = newNode(len[v] + 2);
+            link[u] = len[u] == 1 ? 1 : child(extendable(link[v], i), c);
+            diff[u] = len[u] - len[link[u]];
+            seriesLink[u] = diff[u] == diff[link[u]] ? seriesLink[link[u]] : link[u];
+            sibling[u] = firstChild[v];
+            firstChild[v] = u;
+            edge[u] = c;
         }
-        
-        // Update center and right
-        if(i + p[i] > right) {
-            center = i;
-            right = i + p[i];
+        last = u;
+        return u;
+    }
+    
+    int countDistinct() const { return len.size() - 2; }
+};
+
+// Fewest palindromes s splits into - O(n log n) time, O(n) memory.
+// dp[i] = 1 + min dp[i - len(p)] over palindromic suffixes p of s[0..i);
+// one run of suffixes with equal diff is handled in O(1) through
+// series[v], which reuses the value stored at link[v] diff steps earlier.
+int minPalindromePartition(const string &s) {
+    int n = s.size();
+    Eertree tree;
+    vector<int> dp(n + 1, 0), series(n + 2, 0);
+    for(int i = 1; i <= n; i++) {
+        tree.add(s[i - 1]);
+        dp[i] = INT_MAX;
+        for(int v = tree.last; tree.len[v] > 0; v = tree.seriesLink[v]) {
+            series[v] = dp[i - (tree.len[tree.seriesLink[v]] + tree.diff[v])];
+            if(tree.diff[v] == tree.diff[tree.link[v]]) {
+                series[v] = min(series[v], series[tree.link[v]]);
+            }
+            dp[i] = min(dp[i], series[v] + 1);
         }
     }
+    return dp[n];
+}
+
+// ===== 5. SUFFIX ARRAY (SA-IS) =====
+// Linear-time induced sorting (Nong, Zhang, Chan): classify suffixes as
+// S/L type, bucket-sort the LMS suffixes, induce the rest, and recurse on
+// the reduced string only if LMS substrings are not yet unique.
+// O(n) time. Peak memory is about three indices per character (the SA,
+// the LMS map and the LMS lists) - ~12n bytes with int32_t, ~25n with int64_t.
+
+// SA of s[0..n) with values in [0, upper]. Index is int32_t (texts < 2 GB)
+// or int64_t; Char is unsigned char for bytes or Index for the recursion.
+template<class Index, class Char>
+vector<Index> saIs(const Char *s, Index n, Index upper) {
+    if(n == 0) return {};
+    if(n == 1) return {0};
+    if(n == 2) return s[0] < s[1] ? vector<Index>{0, 1} : vector<Index>{1, 0};
+    
+    vector<Index> sa(n);
+    vector<bool> ls(n);  // true = S-type (suffix smaller than the next one)
+    for(Index i = n - 2; i >= 0; i--) {
+        ls[i] = s[i] == s[i + 1] ? ls[i + 1] : s[i] < s[i + 1];
+    }
+    
+    // Bucket starts: sumL[c] for L-type, sumS[c] for S-type suffixes
+    vector<Index> sumL(upper + 1, 0), sumS(upper + 1, 0);
+    for(Index i = 0; i < n; i++) {
+        if(!ls[i]) sumS[s[i]]++;
+        else sumL[s[i] + 1]++;
+    }
+    for(Index c = 0; c <= upper; c++) {
+        sumS[c] += sumL[c];
+        if(c < upper) sumL[c + 1] += sumS[c];
+    }
     
-    // Find maximum
-    int maxLen = 0, centerIdx = 0;
-    for(int i = 1; i < n - 1; i++) {
-        if(p[i] > maxLen) {
-            maxLen = p[i];
-            centerIdx = i;
+    auto induce = [&](const vector<Index> &lms) {
+        fill(sa.begin(), sa.end(), -1);
+        vector<Index> buf(sumS);
+        for(Index d : lms) {
+            if(d != n) sa[buf[s[d]]++] = d;
+        }
+        buf = sumL;
+        sa[buf[s[n - 1]]++] = n - 1;
+        for(Index i = 0; i < n; i++) {
+            Index v = sa[i];
+            if(v >= 1 && !ls[v - 1]) sa[buf[s[v - 1]]++] = v - 1;
         }
+        buf = sumL;
+        for(Index i = n - 1; i >= 0; i--) {
+            Index v = sa[i];
+            if(v >= 1 && ls[v - 1]) sa[--buf[s[v - 1] + 1]] = v - 1;
+        }
+    };
+    
+    // LMS positions: S-type with an L-type left neighbour
+    vector<Index> lmsMap(n + 1, -1), lms;
+    Index m = 0;
+    for(Index i = 1; i < n; i++) {
+        if(!ls[i - 1] && ls[i]) lmsMap[i] = m++;
+    }
+    lms.reserve(m);
+    for(Index i = 1; i < n; i++) {
+        if(lmsMap[i] != -1) lms.push_back(i);
     }
     
-    int start = (centerIdx - maxLen) / 2;
-    return s.substr(start, maxLen);
+    induce(lms);
+    if(m == 0) return sa;
+    
+    // Name LMS substrings in sorted order; equal substrings share a name
+    vector<Index> sortedLms;
+    sortedLms.reserve(m);
+    for(Index v : sa) {
+        if(lmsMap[v] != -1) sortedLms.push_back(v);
+    }
+    vector<Index> reduced(m);
+    Index names = 0;
+    reduced[lmsMap[sortedLms[0]]] = 0;
+    for(Index i = 1; i < m; i++) {
+        Index l = sortedLms[i - 1], r = sortedLms[i];
+        Index endL = lmsMap[l] + 1 < m ? lms[lmsMap[l] + 1] : n;
+        Index endR = lmsMap[r] + 1 < m ? lms[lmsMap[r] + 1] : n;
+        bool same = endL - l == endR - r;
+        if(same) {
+            while(l < endL && s[l] == s[r]) {
+                l++;
+                r++;
+            }
+            if(l == n || s[l] != s[r]) same = false;
+        }
+        if(!same) names++;
+        reduced[lmsMap[sortedLms[i]]] = names;
+    }
+    
+    // Only lms and reduced are needed across the recursion
+    vector<Index>().swap(lmsMap);
+    vector<Index>().swap(sortedLms);
+    vector<Index>().swap(sa);
+    
+    vector<Index> reducedSa = saIs<Index>(reduced.data(), m, names);
+    vector<Index>().swap(reduced);
+    for(Index i = 0; i < m; i++) reducedSa[i] = lms[reducedSa[i]];
+    sa.resize(n);
+    induce(reducedSa);
+    return sa;
 }
 
-// ===== 5. SUFFIX ARRAY (SIMPLIFIED) =====
-// O(n log^2 n) implementation
+// Texts of 2^31 bytes or more need buildSuffixArray40
+vector<int> buildSuffixArray(const string &s) {
+    assert(s.size() <= (size_t)INT_MAX && "text too long for int indices");
+    return saIs<int>((const unsigned char*)s.data(), (int)s.size(), 255);
+}
 
-struct Suffix {
-    int index;
-    string suffix;
-};
+// Integer alphabet: values of s in [0, upper]
+vector<int> buildSuffixArray(const vector<int> &s, int upper) {
+    assert(s.size() <= (size_t)INT_MAX && "text too long for int indices");
+    return saIs<int>(s.data(), (int)s.size(), upper);
+}
 
-vector<int> buildSuffixArray(string s) {
-    int n = s.length();
-    vector<Suffix> suffixes(n);
+// 40-bit packed suffix array for texts past the 32-bit range (up to 1 TB):
+// 5 bytes per entry instead of 8. Built with 64-bit SA-IS and then packed,
+// so construction still peaks at about 25n bytes; only the result is 5n.
+struct SuffixArray40 {
+    vector<uint8_t> bytes;
     
-    for(int i = 0; i < n; i++) {
-        suffixes[i].index = i;
-        suffixes[i].suffix = s.substr(i);
+    size_t size() const { return bytes.size() / 5; }
+    
+    uint64_t operator[](size_t i) const {
+        uint64_t v = 0;
+        memcpy(&v, &bytes[5 * i], 5);  // Little-endian low 5 bytes
+        return v;
     }
     
-    sort(suffixes.begin(), suffixes.end(),
-         [](const Suffix &a, const Suffix &b) {
-             return a.suffix < b.suffix;
-         });
+    void set(size_t i, uint64_t v) { memcpy(&bytes[5 * i], &v, 5); }
+};
+
+SuffixArray40 buildSuffixArray40(const string &s) {
+    vector<int64_t> sa = saIs<int64_t>((const unsigned char*)s.data(), (int64_t)s.size(), 255);
+    SuffixArray40 packed;
+    packed.bytes.resize(5 * sa.size());
+    for(size_t i = 0; i < sa.size(); i++) packed.set(i, sa[i]);
+    return packed;
+}
+
+// Parallel variant: prefix doubling (Manber-Myers) where every round sorts
+// the keys (rank[i], rank[i + k]) with an LSD radix sort split across
+// threads. O(n log n) work, so it beats SA-IS only with enough cores;
+// stops as soon as all ranks are distinct.
+vector<int> buildSuffixArrayParallel(const string &s, int threads = 0) {
+    int n = s.size();
+    if(threads <= 0) threads = max(1u, thread::hardware_concurrency());
+    threads = max(1, min(threads, n / 65536 + 1));
     
-    vector<int> suffixArray(n);
-    for(int i = 0; i < n; i++) {
-        suffixArray[i] = suffixes[i].index;
+    // Runs body(begin, end, t) on [0, n) split into contiguous chunks
+    auto parallelFor = [&](auto body) {
+        vector<thread> workers;
+        for(int t = 1; t < threads; t++) {
+            workers.emplace_back(body, (long long)n * t / threads, (long long)n * (t + 1) / threads, t);
+        }
+        body(0LL, (long long)n / threads, 0);
+        for(auto &w : workers) w.join();
+    };
+    
+    const int DIGIT = 16, BUCKETS = 1 << DIGIT;
+    vector<int> sa(n), tmpSa(n), rank(n);
+    vector<uint64_t> key(n), tmpKey(n);
+    vector<vector<int>> count(threads, vector<int>(BUCKETS));
+    vector<int> chunkNew(threads);
+    
+    for(int i = 0; i < n; i++) rank[i] = (unsigned char)s[i];
+    int maxRank = 255;
+    
+    for(int k = 1; n > 1; k <<= 1) {
+        parallelFor([&](long long b, long long e, int) {
+            for(long long i = b; i < e; i++) {
+                sa[i] = i;
+                key[i] = (uint64_t)rank[i] << 32 | (i + k < n ? rank[i + k] + 1 : 0);
+            }
+        });
+        
+        // Ranks fit in `bits` bits, so only those digits of each half need passes
+        int bits = 64 - __builtin_clzll((uint64_t)maxRank + 1);
+        vector<int> shifts;
+        for(int half = 0; half < 64; half += 32) {
+            for(int d = 0; d < bits; d += DIGIT) shifts.push_back(half + d);
+        }
+        
+        for(int shift : shifts) {
+            parallelFor([&](long long b, long long e, int t) {
+                fill(count[t].begin(), count[t].end(), 0);
+                for(long long i = b; i < e; i++) count[t][key[i] >> shift & (BUCKETS - 1)]++;
+            });
+            // Bucket-major, thread-minor offsets keep the scatter stable
+            int offset = 0;
+            for(int d = 0; d < BUCKETS; d++) {
+                for(int t = 0; t < threads; t++) {
+                    int c = count[t][d];
+                    count[t][d] = offset;
+                    offset += c;
+                }
+            }
+            parallelFor([&](long long b, long long e, int t) {
+                for(long long i = b; i < e; i++) {
+                    int pos = count[t][key[i] >> shift & (BUCKETS - 1)]++;
+                    tmpKey[pos] = key[i];
+                    tmpSa[pos] = sa[i];
+                }
+            });
+            swap(key, tmpKey);
+            swap(sa, tmpSa);
+        }
+        
+        // New rank = number of key changes before position i (parallel prefix sum)
+        parallelFor([&](long long b, long long e, int t) {
+            int c = 0;
+            for(long long i = max(b, 1LL); i < e; i++) c += key[i] != key[i - 1];
+            chunkNew[t] = c;
+        });
+        for(int t = 1; t < threads; t++) chunkNew[t] += chunkNew[t - 1];
+        parallelFor([&](long long b, long long e, int t) {
+            int r = t > 0 ? chunkNew[t - 1] : 0;
+            for(long long i = b; i < e; i++) {
+                if(i > 0) r += key[i] != key[i - 1];
+                rank[sa[i]] = r;
+            }
+        });
+        maxRank = chunkNew[threads - 1];
+        if(maxRank == n - 1) break;
     }
+    return sa;
+}
+
+// SA-IS vs 40-bit vs parallel doubling on n random bytes over a 4-letter alphabet
+void benchmarkSuffixArray(int n) {
+    mt19937 rng(11);
+    string text(n, 'a');
+    for(char &c : text) c = "acgt"[rng() % 4];
+    
+    auto time = [](auto &&body) {
+        auto start = chrono::steady_clock::now();
+        body();
+        return chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+    };
+    
+    vector<int> sais, parallel;
+    SuffixArray40 packed;
+    double tSais = time([&]() { sais = buildSuffixArray(text); });
+    double tPacked = time([&]() { packed = buildSuffixArray40(text); });
+    double tParallel = time([&]() { parallel = buildSuffixArrayParallel(text); });
+    
+    bool same = sais == parallel && packed.size() == sais.size();
+    for(size_t i = 0; same && i < sais.size(); i++) same = packed[i] == (uint64_t)sais[i];
     
-    return suffixArray;
+    cout << "Suffix array of " << n << " bytes: SA-IS " << tSais << " ms, 40-bit "
+         << tPacked << " ms, parallel doubling (" << thread::hardware_concurrency()
+         << " threads) " << tParallel << " ms" << (same ? "" : " (MISMATCH)") << endl;
 }
 
 // ===== 6. LONGEST COMMON PREFIX ARRAY =====
-vector<int> buildLCP(string s, vector<int> &suffixArray) {
+// Kasai: lcp[i] = LCP of suffixes sa[i] and sa[i + 1] - O(n)
+vector<int> buildLCP(const string &s, const vector<int> &suffixArray) {
     int n = s.length();
     vector<int> lcp(n, 0);
     vector<int> rank(n);
@@ -294,7 +820,8 @@ vector<int> buildLCP(string s, vector<int> &suffixArray) {
 }
 
 // ===== 7. LONGEST REPEATING SUBSTRING =====
-string longestRepeatingSubstring(string s) {
+// O(n) on top of SA-IS + Kasai
+string longestRepeatingSubstring(const string &s) {
     vector<int> suffixArray = buildSuffixArray(s);
     vector<int> lcp = buildLCP(s, suffixArray);
     
@@ -309,18 +836,45 @@ string longestRepeatingSubstring(string s) {
     return s.substr(start, maxLen);
 }
 
-// ===== 8. MINIMUM ROTATION (LEXICOGRAPHICALLY SMALLEST) =====
-int minRotation(string s) {
-    int n = s.length();
-    s += s;  // Double the string
-    int i = 0, ans = 0;
+// ===== 8. MINIMUM ROTATION AND LYNDON FACTORIZATION =====
+// Lyndon word: strictly smaller than all its proper rotations. Every string
+// is uniquely w1 >= w2 >= ... >= wk with each wi Lyndon (Chen-Fox-Lyndon);
+// Duval's algorithm finds it in O(n) time, O(1) extra space.
+
+// Start positions of the Lyndon factors of s
+vector<size_t> lyndonFactorization(string_view s) {
+    size_t n = s.length();
+    vector<size_t> starts;
+    size_t i = 0;
+    while(i < n) {
+        size_t j = i + 1, k = i;
+        while(j < n && s[k] <= s[j]) {
+            if(s[k] < s[j]) k = i;
+            else k++;
+            j++;
+        }
+        while(i <= k) {
+            starts.push_back(i);
+            i += j - k;
+        }
+    }
+    return starts;
+}
+
+// Start of the lexicographically smallest rotation - O(n), no copy.
+// Duval over s + s, reading position x < 2n as s[x - n] when x >= n.
+// size_t indices: 2n must not overflow for strings past 1 GB.
+size_t minRotation(string_view s) {
+    size_t n = s.length();
+    auto at = [&](size_t x) { return x < n ? s[x] : s[x - n]; };
+    size_t i = 0, ans = 0;
     
     while(i < n) {
         ans = i;
-        int j = i + 1, k = i;
+        size_t j = i + 1, k = i;
         
-        while(j < 2 * n && s[k] <= s[j]) {
-            if(s[k] < s[j]) {
+        while(j < 2 * n && at(k) <= at(j)) {
+            if(at(k) < at(j)) {
                 k = i;
             } else {
                 k++;
@@ -336,44 +890,1287 @@ int minRotation(string s) {
     return ans;
 }
 
+// Fingerprint of the minimal rotation: the same value for every rotation of
+// s, so cyclic identifiers can be deduplicated by hash. Polynomial hash mod
+// 2^61 - 1 with a fixed base (stable across runs), length mixed in.
+uint64_t rotationFingerprint(string_view s, size_t start) {
+    const uint64_t FINGERPRINT_BASE = 0x1F3D5B79A2C4E687ULL % MERSENNE61;
+    size_t n = s.length();
+    uint64_t h = n;
+    for(size_t k = 0, x = start; k < n; k++, x = x + 1 == n ? 0 : x + 1) {
+        h = mulMod61(h, FINGERPRINT_BASE) + (unsigned char)s[x] + 1;
+        if(h >= MERSENNE61) h -= MERSENNE61;
+    }
+    return h;
+}
+
+uint64_t rotationFingerprint(string_view s) {
+    return rotationFingerprint(s, minRotation(s));
+}
+
+// All strings back to back in one buffer: one allocation instead of one per
+// string, 8 bytes of offset per string.
+struct StringArena {
+    string data;
+    vector<uint64_t> offsets = {0};
+    
+    void add(string_view s) {
+        data.append(s);
+        offsets.push_back(data.size());
+    }
+    
+    size_t size() const { return offsets.size() - 1; }
+    string_view operator[](size_t i) const {
+        return string_view(data).substr(offsets[i], offsets[i + 1] - offsets[i]);
+    }
+};
+
+// Batch canonicalization: minimal-rotation start and fingerprint of every
+// string in an arena, chunks split across threads - O(total length)
+struct RotationBatch {
+    vector<uint64_t> start;
+    vector<uint64_t> fingerprint;
+};
+
+RotationBatch canonicalRotations(const StringArena &strs, int threads = 0) {
+    size_t n = strs.size();
+    if(threads <= 0) threads = max(1u, thread::hardware_concurrency());
+    threads = max<size_t>(1, min<size_t>(threads, n / 4096 + 1));
+    
+    RotationBatch batch;
+    batch.start.resize(n);
+    batch.fingerprint.resize(n);
+    auto work = [&](int t) {
+        for(size_t i = n * t / threads; i < n * (t + 1) / threads; i++) {
+            batch.start[i] = minRotation(strs[i]);
+            batch.fingerprint[i] = rotationFingerprint(strs[i], batch.start[i]);
+        }
+    };
+    vector<thread> workers;
+    for(int t = 1; t < threads; t++) workers.emplace_back(work, t);
+    work(0);
+    for(auto &w : workers) w.join();
+    return batch;
+}
+
+// Canonical rotations of n random 16-byte identifiers: the previous
+// minRotation (Duval over a doubled copy) vs in-place minRotation vs the
+// batched arena API
+void benchmarkRotations(int n) {
+    mt19937 rng(23);
+    vector<string> ids(n);
+    StringArena arena;
+    for(string &s : ids) {
+        s.resize(16);
+        for(char &c : s) c = 'a' + rng() % 4;
+        arena.add(s);
+    }
+    
+    auto time = [](auto &&body) {
+        auto start = chrono::steady_clock::now();
+        body();
+        return chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+    };
+    
+    // Old approach: the same Duval scan, but on a by-value copy doubled with s += s
+    auto minRotationCopy = [](string s) {
+        int n = s.length();
+        s += s;
+        int i = 0, ans = 0;
+        while(i < n) {
+            ans = i;
+            int j = i + 1, k = i;
+            while(j < 2 * n && s[k] <= s[j]) {
+                if(s[k] < s[j]) k = i;
+                else k++;
+                j++;
+            }
+            while(i <= k) i += j - k;
+        }
+        return ans;
+    };
+    vector<int> copied(n);
+    double tCopy = time([&]() {
+        for(int i = 0; i < n; i++) copied[i] = minRotationCopy(ids[i]);
+    });
+    vector<size_t> starts(n);
+    double tInPlace = time([&]() {
+        for(int i = 0; i < n; i++) starts[i] = minRotation(ids[i]);
+    });
+    RotationBatch batch;
+    double tBatch = time([&]() { batch = canonicalRotations(arena); });
+    
+    bool same = true;
+    for(int i = 0; i < n; i++) {
+        same &= (size_t)copied[i] == starts[i] && batch.start[i] == starts[i];
+    }
+    
+    cout << "Canonical rotations of " << n << " ids (ms): doubled copy " << tCopy
+         << ", minRotation " << tInPlace << ", batch + fingerprints " << tBatch
+         << (same ? "" : " (MISMATCH)") << endl;
+}
+
 // ===== 9. ANAGRAM GROUPING =====
-vector<vector<string>> groupAnagrams(vector<string> &strs) {
-    map<string, vector<string>> groups;
+// Anagrams share a character histogram, so the key is a hash of the
+// histogram - sum of a random 64-bit value per character, O(len), no
+// sorting - and a hash match is confirmed by counting characters against
+// the group's first member, so collisions cannot merge groups.
+// Groups are index lists (CSR); strings are never copied. Input can be a
+// StringArena (section 8).
+
+// Group g = members[start[g] .. start[g + 1]), indices ascending within a group
+struct AnagramGroups {
+    vector<uint32_t> members;
+    vector<uint32_t> start = {0};
+    
+    size_t size() const { return start.size() - 1; }
+};
+
+uint64_t histogramHash(string_view s) {
+    static const vector<uint64_t> charValue = [] {
+        mt19937_64 rng(0x5EED);
+        vector<uint64_t> v(256);
+        for(uint64_t &x : v) x = rng();
+        return v;
+    }();
+    uint64_t h = s.size() * 0x9E3779B97F4A7C15ULL;
+    for(unsigned char c : s) h += charValue[c];
+    return h;
+}
+
+// Same histogram? O(len) with a zeroed scratch count array (left zeroed)
+bool sameHistogram(string_view a, string_view b, int *count) {
+    if(a.size() != b.size()) return false;
+    for(unsigned char c : a) count[c]++;
+    for(unsigned char c : b) count[c]--;
+    bool same = true;
+    for(unsigned char c : a) same &= count[c] == 0;
+    for(unsigned char c : a) count[c] = 0;
+    for(unsigned char c : b) count[c] = 0;
+    return same;
+}
+
+// Group the strings whose indices are listed in ids (hashes precomputed).
+// Open addressing on the hash; equal hashes with different histograms just
+// probe on. Groups come out in order of first member.
+template<class Strings>
+AnagramGroups groupByHistogram(const Strings &strs, const vector<uint64_t> &hashes,
+                               const vector<uint32_t> &ids) {
+    size_t cap = 2;
+    while(cap < 2 * ids.size()) cap <<= 1;
+    vector<uint32_t> slotGroup(cap, UINT32_MAX), groupFirst;
+    vector<uint32_t> groupOf(ids.size()), groupSize;
+    int count[256] = {};
+    
+    for(size_t k = 0; k < ids.size(); k++) {
+        uint32_t id = ids[k];
+        size_t slot = hashes[id] & (cap - 1);
+        while(true) {
+            uint32_t g = slotGroup[slot];
+            if(g == UINT32_MAX) {
+                g = groupFirst.size();
+                slotGroup[slot] = g;
+                groupFirst.push_back(id);
+                groupSize.push_back(0);
+            }
+            uint32_t first = groupFirst[g];
+            if(hashes[first] == hashes[id] && (first == id || sameHistogram(strs[first], strs[id], count))) {
+                groupOf[k] = g;
+                groupSize[g]++;
+                break;
+            }
+            slot = (slot + 1) & (cap - 1);
+        }
+    }
     
-    for(string &s : strs) {
-        string key = s;
-        sort(key.begin(), key.end());
-        groups[key].push_back(s);
+    AnagramGroups result;
+    result.start.resize(groupSize.size() + 1);
+    for(size_t g = 0; g < groupSize.size(); g++) result.start[g + 1] = result.start[g] + groupSize[g];
+    result.members.resize(ids.size());
+    vector<uint32_t> cursor(result.start.begin(), result.start.end() - 1);
+    for(size_t k = 0; k < ids.size(); k++) result.members[cursor[groupOf[k]]++] = ids[k];
+    return result;
+}
+
+// Strings: anything with size() and operator[] giving a string_view
+// (StringArena, vector<string>, vector<string_view>) - O(total length)
+template<class Strings>
+AnagramGroups groupAnagramIndices(const Strings &strs) {
+    vector<uint64_t> hashes(strs.size());
+    vector<uint32_t> ids(strs.size());
+    for(size_t i = 0; i < strs.size(); i++) {
+        hashes[i] = histogramHash(strs[i]);
+        ids[i] = i;
     }
+    return groupByHistogram(strs, hashes, ids);
+}
+
+// Parallel: threads hash their chunk, strings are partitioned by the top
+// hash bits (anagrams always land in the same partition), and each thread
+// groups one partition with its own table. Groups are listed partition by
+// partition instead of by first member.
+template<class Strings>
+AnagramGroups groupAnagramIndicesParallel(const Strings &strs, int threads = 0) {
+    size_t n = strs.size();
+    if(threads <= 0) threads = max(1u, thread::hardware_concurrency());
+    int bits = 0;
+    while((1 << bits) < threads) bits++;
+    int parts = 1 << bits;
     
-    vector<vector<string>> result;
-    for(auto &pair : groups) {
-        result.push_back(pair.second);
+    auto runAll = [&](int tasks, auto body) {
+        vector<thread> workers;
+        for(int t = 0; t < tasks; t++) workers.emplace_back(body, t);
+        for(auto &w : workers) w.join();
+    };
+    auto partOf = [&](uint64_t h) { return bits ? (int)(h >> (64 - bits)) : 0; };
+    
+    vector<uint64_t> hashes(n);
+    vector<vector<uint32_t>> partIds(parts);
+    vector<vector<vector<uint32_t>>> local(threads, vector<vector<uint32_t>>(parts));
+    runAll(threads, [&](int t) {
+        for(size_t i = n * t / threads; i < n * (t + 1) / threads; i++) {
+            hashes[i] = histogramHash(strs[i]);
+            local[t][partOf(hashes[i])].push_back(i);
+        }
+    });
+    // Chunks are in index order, so each partition stays sorted by index
+    for(int p = 0; p < parts; p++) {
+        for(int t = 0; t < threads; t++) {
+            partIds[p].insert(partIds[p].end(), local[t][p].begin(), local[t][p].end());
+            vector<uint32_t>().swap(local[t][p]);
+        }
     }
     
+    vector<AnagramGroups> partial(parts);
+    runAll(parts, [&](int p) { partial[p] = groupByHistogram(strs, hashes, partIds[p]); });
+    
+    AnagramGroups result;
+    result.members.reserve(n);
+    for(const AnagramGroups &g : partial) {
+        uint32_t base = result.members.size();
+        result.members.insert(result.members.end(), g.members.begin(), g.members.end());
+        for(size_t k = 1; k < g.start.size(); k++) result.start.push_back(base + g.start[k]);
+    }
     return result;
 }
 
-// ===== 10. LONGEST COMMON SUBSTRING =====
-string longestCommonSubstring(string s1, string s2) {
+vector<vector<string>> groupAnagrams(vector<string> &strs) {
+    AnagramGroups groups = groupAnagramIndices(strs);
+    vector<vector<string>> result(groups.size());
+    for(size_t g = 0; g < groups.size(); g++) {
+        for(uint32_t k = groups.start[g]; k < groups.start[g + 1]; k++) {
+            result[g].push_back(strs[groups.members[k]]);
+        }
+    }
+    return result;
+}
+
+// n short tokens over a 6-letter alphabet: sorted-key std::map vs histogram
+// hashing over an arena, sequential and parallel
+void benchmarkAnagramGrouping(int n) {
+    mt19937 rng(17);
+    vector<string> words(n);
+    StringArena arena;
+    for(string &w : words) {
+        w.resize(3 + rng() % 6);
+        for(char &c : w) c = 'a' + rng() % 6;
+        arena.add(w);
+    }
+    
+    auto time = [](auto &&body) {
+        auto start = chrono::steady_clock::now();
+        body();
+        return chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+    };
+    
+    size_t sortedGroups = 0;
+    double tSorted = time([&]() {
+        map<string, vector<int>> groups;
+        for(int i = 0; i < n; i++) {
+            string key = words[i];
+            sort(key.begin(), key.end());
+            groups[key].push_back(i);
+        }
+        sortedGroups = groups.size();
+    });
+    AnagramGroups seq, par;
+    double tSeq = time([&]() { seq = groupAnagramIndices(arena); });
+    double tPar = time([&]() { par = groupAnagramIndicesParallel(arena); });
+    
+    cout << "Group " << n << " tokens (ms): sorted keys + map " << tSorted << ", histogram hash "
+         << tSeq << ", parallel " << tPar << " (" << seq.size() << " groups)"
+         << (seq.size() == sortedGroups && par.size() == sortedGroups ? "" : " (MISMATCH)") << endl;
+}
+
+// ===== 10. SUFFIX AUTOMATON AND LONGEST COMMON SUBSTRING =====
+// Suffix automaton: the minimal DFA of all substrings of s, at most 2n - 1
+// states, built online in O(n * sigma). Transitions are one flat array
+// next[state * sigma + code]; the alphabet is given (sorted, it also fixes
+// the order for kthSubstring) or taken from the distinct bytes of s.
+// Memory: 2n * (sigma + 3) ints.
+
+struct SuffixAutomaton {
+    int sigma;
+    int code[256];            // Byte -> alphabet index, -1 if not in the alphabet
+    string alphabet;
+    vector<int> next, link, len;
+    vector<int> firstEnd;     // End position in s of the first occurrence
+    int last = 0;
+    
+    SuffixAutomaton(string_view s, string_view alphabetChars = "") {
+        if(alphabetChars.empty()) {
+            bool seen[256] = {};
+            for(unsigned char c : s) seen[c] = true;
+            for(int c = 0; c < 256; c++) {
+                if(seen[c]) alphabet += (char)c;
+            }
+        } else {
+            alphabet = alphabetChars;
+            sort(alphabet.begin(), alphabet.end());
+            alphabet.erase(unique(alphabet.begin(), alphabet.end()), alphabet.end());
+        }
+        sigma = max<int>(1, alphabet.size());
+        fill(code, code + 256, -1);
+        for(size_t k = 0; k < alphabet.size(); k++) code[(unsigned char)alphabet[k]] = k;
+        
+        size_t maxStates = 2 * s.size() + 1;
+        next.reserve(maxStates * sigma);
+        link.reserve(maxStates);
+        len.reserve(maxStates);
+        firstEnd.reserve(maxStates);
+        newState(0, -1, -1);
+        for(size_t i = 0; i < s.size(); i++) {
+            assert(code[(unsigned char)s[i]] >= 0 && "character outside the alphabet");
+            extend(code[(unsigned char)s[i]], i);
+        }
+    }
+    
+    int newState(int length, int suffixLink, int end) {
+        next.resize(next.size() + sigma, -1);
+        link.push_back(suffixLink);
+        len.push_back(length);
+        firstEnd.push_back(end);
+        return len.size() - 1;
+    }
+    
+    int size() const { return len.size(); }
+    int go(int v, int c) const { return next[(size_t)v * sigma + c]; }
+    
+    void extend(int c, int pos) {
+        int cur = newState(len[last] + 1, 0, pos);
+        int p = last;
+        while(p != -1 && go(p, c) == -1) {
+            next[(size_t)p * sigma + c] = cur;
+            p = link[p];
+        }
+        if(p != -1) {
+            int q = go(p, c);
+            if(len[p] + 1 == len[q]) {
+                link[cur] = q;
+            } else {
+                int clone = newState(len[p] + 1, link[q], firstEnd[q]);
+                copy(next.begin() + (size_t)q * sigma, next.begin() + (size_t)(q + 1) * sigma,
+                     next.begin() + (size_t)clone * sigma);
+                while(p != -1 && go(p, c) == q) {
+                    next[(size_t)p * sigma + c] = clone;
+                    p = link[p];
+                }
+                link[q] = link[cur] = clone;
+            }
+        }
+        last = cur;
+    }
+    
+    // States sorted by len, decreasing (counting sort) - children before links
+    vector<int> byLenDesc() const {
+        vector<int> count(len[last] + 2, 0), order(size());
+        for(int l : len) count[l]++;
+        for(int l = len[last]; l > 0; l--) count[l - 1] += count[l];
+        for(int v = size() - 1; v >= 0; v--) order[--count[len[v]]] = v;
+        return order;
+    }
+    
+    // Number of distinct non-empty substrings - O(states)
+    long long countDistinct() const {
+        long long total = 0;
+        for(int v = 1; v < size(); v++) total += len[v] - len[link[v]];
+        return total;
+    }
+    
+    // k-th (1-based) distinct substring in alphabet order, "" if k is too large.
+    // paths[v] = distinct non-empty strings readable from v; O(states * sigma)
+    // to count, then O(answer length * sigma) to walk.
+    string kthSubstring(long long k) const {
+        vector<long long> paths(size(), 0);
+        for(int v : byLenDesc()) {
+            for(int c = 0; c < sigma; c++) {
+                int u = go(v, c);
+                if(u != -1) paths[v] += 1 + paths[u];
+            }
+        }
+        if(k < 1 || k > paths[0]) return "";
+        
+        string result;
+        int v = 0;
+        while(k > 0) {
+            for(int c = 0; c < sigma; c++) {
+                int u = go(v, c);
+                if(u == -1) continue;
+                if(k <= 1 + paths[u]) {
+                    result += alphabet[c];
+                    k--;      // The string ending here
+                    v = u;
+                    break;
+                }
+                k -= 1 + paths[u];
+            }
+        }
+        return result;
+    }
+};
+
+// Longest substring common to all strings - O(total length * sigma) time,
+// O(|strs[0]| * sigma) memory. Runs each other string through the automaton
+// of strs[0], keeping per state the longest match ending there.
+string longestCommonSubstring(const vector<string> &strs) {
+    if(strs.empty()) return "";
+    SuffixAutomaton sam(strs[0]);
+    vector<int> order = sam.byLenDesc();
+    vector<int> common(sam.len), best(sam.size());
+    
+    for(size_t k = 1; k < strs.size(); k++) {
+        fill(best.begin(), best.end(), 0);
+        int v = 0, l = 0;
+        for(unsigned char ch : strs[k]) {
+            int c = sam.code[ch];
+            if(c < 0) {
+                v = l = 0;
+                continue;
+            }
+            while(v != 0 && sam.go(v, c) == -1) {
+                v = sam.link[v];
+                l = sam.len[v];
+            }
+            if(sam.go(v, c) != -1) {
+                v = sam.go(v, c);
+                l++;
+            }
+            best[v] = max(best[v], l);
+        }
+        // A match ending at v also ends at every suffix-link ancestor
+        for(int u : order) {
+            if(u == 0) continue;
+            int p = sam.link[u];
+            best[p] = max(best[p], min(best[u], sam.len[p]));
+            common[u] = min(common[u], best[u]);
+        }
+    }
+    
+    int bestState = 0;
+    for(int u = 1; u < sam.size(); u++) {
+        if(common[u] > common[bestState]) bestState = u;
+    }
+    int length = bestState ? common[bestState] : 0;
+    return strs[0].substr(sam.firstEnd[bestState] + 1 - length, length);
+}
+
+string longestCommonSubstring(const string &s1, const string &s2) {
+    return longestCommonSubstring(vector<string>{s1, s2});
+}
+
+// Same with hashing: binary search on the length L, checking each L by
+// looking up the sorted window hashes of s1 from s2.
+// O((m + n) log(m + n) log(min(m, n))) time, O(m + n) memory.
+string longestCommonSubstringHashed(const string &s1, const string &s2) {
+    PrefixHash h1(s1), h2(s2);
     int m = s1.length(), n = s2.length();
-    vector<vector<int>> dp(m + 1, vector<int>(n + 1, 0));
     
-    int maxLen = 0, endIndex = 0;
+    // Start in s1 of a common substring of length len, or -1
+    auto common = [&](int len) {
+        vector<pair<uint64_t, int>> windows;
+        for(int i = 0; i + len <= m; i++) windows.push_back({h1.hash(i, i + len), i});
+        sort(windows.begin(), windows.end());
+        for(int j = 0; j + len <= n; j++) {
+            auto it = lower_bound(windows.begin(), windows.end(), make_pair(h2.hash(j, j + len), -1));
+            if(it != windows.end() && it->first == h2.hash(j, j + len)) return it->second;
+        }
+        return -1;
+    };
+    
+    int lo = 0, hi = min(m, n), start = 0;
+    while(lo < hi) {
+        int mid = (lo + hi + 1) / 2;
+        int pos = common(mid);
+        if(pos >= 0) {
+            lo = mid;
+            start = pos;
+        } else {
+            hi = mid - 1;
+        }
+    }
+    return s1.substr(start, lo);
+}
+
+// ===== 11. FM-INDEX (COMPRESSED FULL-TEXT INDEX) =====
+// Substring queries without rescanning the text. Built from the suffix array:
+//   BWT      : bwt[i] = character before the i-th smallest suffix of s + '$'
+//   rank     : Huffman-shaped wavelet tree over the BWT, so the index takes
+//              about H0(s) bits per character (plus 1/8 for rank blocks)
+//   samples  : SA values at text positions divisible by sampleRate
+// count(P) is O(|P| * H0) by backward search; locate adds up to sampleRate
+// LF steps per occurrence. Symbol 0 is '$', byte c is symbol c + 1.
+
+// Bitvector with rank in O(1): cumulative counts every 256 bits (12.5% extra)
+struct RankBitVector {
+    size_t n = 0;
+    vector<uint64_t> words;
+    vector<uint32_t> blocks;  // Ones before each 4-word block
+    
+    void resize(size_t bits) {
+        n = bits;
+        words.assign((bits + 63) / 64, 0);
+    }
     
-    for(int i = 1; i <= m; i++) {
-        for(int j = 1; j <= n; j++) {
-            if(s1[i - 1] == s2[j - 1]) {
-                dp[i][j] = dp[i - 1][j - 1] + 1;
-                if(dp[i][j] > maxLen) {
-                    maxLen = dp[i][j];
-                    endIndex = i - 1;
+    void set(size_t i) { words[i / 64] |= 1ULL << (i % 64); }
+    bool get(size_t i) const { return words[i / 64] >> (i % 64) & 1; }
+    
+    void buildRank() {
+        blocks.assign(words.size() / 4 + 1, 0);
+        uint32_t ones = 0;
+        for(size_t w = 0; w < words.size(); w++) {
+            if(w % 4 == 0) blocks[w / 4] = ones;
+            ones += __builtin_popcountll(words[w]);
+        }
+        if(words.size() % 4 == 0) blocks[words.size() / 4] = ones;
+    }
+    
+    // Ones in [0, i)
+    size_t rank1(size_t i) const {
+        size_t w = i / 64;
+        size_t r = blocks[w / 4];
+        for(size_t k = w / 4 * 4; k < w; k++) r += __builtin_popcountll(words[k]);
+        if(i % 64) r += __builtin_popcountll(words[w] << (64 - i % 64));
+        return r;
+    }
+    
+    size_t memoryBytes() const { return words.size() * 8 + blocks.size() * 4; }
+};
+
+const uint32_t FM_MAGIC = 0x494D465A;  // "ZFMI"
+const uint32_t FM_VERSION = 1;
+const int FM_SYMBOLS = 257;
+
+class FMIndex {
+    // Wavelet tree node; child < 0 is the leaf of symbol -(child + 1)
+    struct Node {
+        RankBitVector bits;
+        int child[2];
+    };
+    
+    uint32_t n = 0, sampleRate = 32;
+    vector<uint32_t> C;               // Rows starting with a smaller symbol
+    vector<uint64_t> code;            // Huffman code per symbol, root bit first (LSB)
+    vector<uint8_t> codeLen;
+    vector<Node> nodes;
+    int root = -1;
+    RankBitVector sampled;            // Rows whose SA value is sampled
+    vector<uint32_t> samples;         // Their SA values, in row order
+    
+    // Rows [0, i) of the BWT holding symbol sym
+    size_t rank(int sym, size_t i) const {
+        int node = root;
+        for(int d = 0; d < codeLen[sym]; d++) {
+            int bit = code[sym] >> d & 1;
+            size_t ones = nodes[node].bits.rank1(i);
+            i = bit ? ones : i - ones;
+            node = nodes[node].child[bit];
+        }
+        return i;
+    }
+    
+    // LF mapping: row of the suffix one position to the left
+    size_t lf(size_t row) const {
+        int node = root;
+        while(node >= 0) {
+            const RankBitVector &bits = nodes[node].bits;
+            int bit = bits.get(row);
+            size_t ones = bits.rank1(row);
+            row = bit ? ones : row - ones;
+            node = nodes[node].child[bit];
+        }
+        return C[-(node + 1)] + row;
+    }
+    
+    void buildHuffman(const vector<uint64_t> &freq) {
+        // Heap of (weight, tree id); ids >= 0 are nodes, < 0 are leaves
+        priority_queue<pair<uint64_t, int>, vector<pair<uint64_t, int>>, greater<>> heap;
+        for(int s = 0; s < FM_SYMBOLS; s++) {
+            if(freq[s]) heap.push({freq[s], -(s + 1)});
+        }
+        nodes.clear();
+        while(heap.size() > 1) {
+            auto a = heap.top(); heap.pop();
+            auto b = heap.top(); heap.pop();
+            nodes.push_back({RankBitVector(), {a.second, b.second}});
+            heap.push({a.first + b.first, (int)nodes.size() - 1});
+        }
+        root = heap.top().second;
+        
+        code.assign(FM_SYMBOLS, 0);
+        codeLen.assign(FM_SYMBOLS, 0);
+        vector<pair<int, pair<uint64_t, int>>> st = {{root, {0, 0}}};
+        while(!st.empty()) {
+            int id = st.back().first;
+            uint64_t bits = st.back().second.first;
+            int len = st.back().second.second;
+            st.pop_back();
+            if(id < 0) {
+                code[-(id + 1)] = bits;
+                codeLen[-(id + 1)] = len;
+                continue;
+            }
+            for(int b = 0; b < 2; b++) {
+                st.push_back({nodes[id].child[b], {bits | (uint64_t)b << len, len + 1}});
+            }
+        }
+    }
+    
+    // Split seq by the current code bit into each node's bitvector, level by level
+    void buildWaveletTree(vector<uint16_t> &seq) {
+        // (node, begin, end, depth) ranges of seq, stably partitioned in place
+        vector<tuple<int, size_t, size_t, int>> work;
+        if(root >= 0) work.push_back({root, 0, seq.size(), 0});
+        vector<uint16_t> right;
+        while(!work.empty()) {
+            auto [node, b, e, depth] = work.back();
+            work.pop_back();
+            RankBitVector &bits = nodes[node].bits;
+            bits.resize(e - b);
+            
+            right.clear();
+            size_t w = b;
+            for(size_t i = b; i < e; i++) {
+                if(code[seq[i]] >> depth & 1) {
+                    bits.set(i - b);
+                    right.push_back(seq[i]);
+                } else {
+                    seq[w++] = seq[i];
                 }
             }
+            copy(right.begin(), right.end(), seq.begin() + w);
+            bits.buildRank();
+            
+            for(int bit = 0; bit < 2; bit++) {
+                int child = nodes[node].child[bit];
+                size_t cb = bit ? w : b, ce = bit ? e : w;
+                if(child >= 0) work.push_back({child, cb, ce, depth + 1});
+            }
+        }
+    }
+    
+    static void writeBits(ofstream &out, const RankBitVector &bits) {
+        uint64_t size = bits.n;
+        out.write((const char*)&size, sizeof(size));
+        out.write((const char*)bits.words.data(), bits.words.size() * sizeof(uint64_t));
+    }
+    
+    // Fails instead of allocating if the stored size exceeds what is left of the file
+    static bool readBits(ifstream &in, RankBitVector &bits, uint64_t fileBytes) {
+        uint64_t size = 0;
+        if(!in.read((char*)&size, sizeof(size))) return false;
+        uint64_t wordBytes = (size + 63) / 64 * sizeof(uint64_t);
+        if(size > fileBytes * 8 || wordBytes > fileBytes - (uint64_t)in.tellg()) return false;
+        bits.resize(size);
+        if(!in.read((char*)bits.words.data(), wordBytes)) return false;
+        if(size % 64 && bits.words.back() >> size % 64) return false;  // Padding must be zero
+        bits.buildRank();
+        return true;
+    }
+    
+    // A loaded tree must reach every row exactly once: each node visited once
+    // from the root, its bitvector as long as the rows routed to it, and each
+    // leaf matching its stored code and the size of its C range
+    bool validTree() const {
+        vector<bool> seenNode(nodes.size(), false), seenLeaf(FM_SYMBOLS, false);
+        // (id, rows reaching it, code bits so far, depth)
+        vector<tuple<int, uint64_t, uint64_t, int>> st = {{root, (uint64_t)n + 1, 0, 0}};
+        while(!st.empty()) {
+            auto [id, rows, bits, len] = st.back();
+            st.pop_back();
+            if(id < 0) {
+                int sym = -(id + 1);
+                if(sym >= FM_SYMBOLS || seenLeaf[sym]) return false;
+                seenLeaf[sym] = true;
+                if(codeLen[sym] != len || code[sym] != bits || C[sym + 1] - C[sym] != rows) return false;
+                continue;
+            }
+            if(id >= (int)nodes.size() || seenNode[id] || len >= 64) return false;
+            seenNode[id] = true;
+            const RankBitVector &bv = nodes[id].bits;
+            if(bv.n != rows) return false;
+            uint64_t ones = bv.rank1(rows);
+            for(int b = 0; b < 2; b++) {
+                st.push_back({nodes[id].child[b], b ? ones : rows - ones, bits | (uint64_t)b << len, len + 1});
+            }
+        }
+        for(int sym = 0; sym < FM_SYMBOLS; sym++) {
+            if(!seenLeaf[sym] && (C[sym + 1] != C[sym] || code[sym] || codeLen[sym])) return false;
+        }
+        return true;
+    }
+    
+public:
+    FMIndex() {}
+    
+    // O(n) on top of SA-IS; text must be shorter than 2^31 bytes
+    FMIndex(const string &s, uint32_t sampleRate = 32) : n(s.size()), sampleRate(sampleRate) {
+        vector<int> sa = buildSuffixArray(s);
+        
+        // Row 0 is the '$' suffix; row i + 1 is suffix sa[i]
+        vector<uint16_t> bwt(n + 1);
+        vector<uint64_t> freq(FM_SYMBOLS, 0);
+        sampled.resize(n + 1);
+        bwt[0] = n ? (unsigned char)s[n - 1] + 1 : 0;
+        for(uint32_t row = 0; row <= n; row++) {
+            uint32_t pos = row == 0 ? n : sa[row - 1];
+            if(row > 0) bwt[row] = pos == 0 ? 0 : (unsigned char)s[pos - 1] + 1;
+            freq[bwt[row]]++;
+            if(pos % sampleRate == 0) {
+                sampled.set(row);
+                samples.push_back(pos);
+            }
+        }
+        sampled.buildRank();
+        sa = vector<int>();
+        
+        C.assign(FM_SYMBOLS + 1, 0);
+        for(int c = 0; c < FM_SYMBOLS; c++) C[c + 1] = C[c] + freq[c];
+        
+        buildHuffman(freq);
+        buildWaveletTree(bwt);
+    }
+    
+    uint32_t size() const { return n; }
+    
+    // Rows [sp, ep) of suffixes starting with pattern. The empty pattern
+    // matches nothing, so count("") is 0 (as with KMPSearch).
+    pair<size_t, size_t> range(const string &pattern) const {
+        if(pattern.empty()) return {0, 0};
+        size_t sp = 0, ep = n + 1;
+        for(size_t k = pattern.size(); k-- > 0 && sp < ep; ) {
+            int sym = (unsigned char)pattern[k] + 1;
+            if(C[sym + 1] == C[sym]) return {0, 0};
+            sp = C[sym] + rank(sym, sp);
+            ep = C[sym] + rank(sym, ep);
+        }
+        return {sp, max(sp, ep)};
+    }
+    
+    size_t count(const string &pattern) const {
+        auto r = range(pattern);
+        return r.second - r.first;
+    }
+    
+    // Sorted start positions of all occurrences
+    vector<int> locate(const string &pattern) const {
+        auto r = range(pattern);
+        vector<int> result;
+        result.reserve(r.second - r.first);
+        for(size_t row = r.first; row < r.second; row++) {
+            // A sample is always < sampleRate LF steps away; the bound keeps a
+            // corrupt BWT that load() could not detect from looping forever
+            size_t cur = row, steps = 0;
+            while(!sampled.get(cur) && steps < sampleRate) {
+                cur = lf(cur);
+                steps++;
+            }
+            if(!sampled.get(cur)) continue;
+            result.push_back(samples[sampled.rank1(cur)] + steps);
+        }
+        sort(result.begin(), result.end());
+        return result;
+    }
+    
+    size_t memoryBytes() const {
+        size_t bytes = C.size() * 4 + code.size() * 9 + sampled.memoryBytes() + samples.size() * 4;
+        for(const Node &node : nodes) bytes += node.bits.memoryBytes() + sizeof(Node);
+        return bytes;
+    }
+    
+    // File: magic, version, n, sampleRate, root, C, codes, nodes, samples.
+    // Rank blocks are rebuilt on load instead of stored. load() checks sizes
+    // and tree structure in O(file size) and leaves the index unchanged on failure.
+    bool save(const string &path) const {
+        ofstream out(path, ios::binary);
+        if(!out) return false;
+        uint32_t header[4] = {FM_MAGIC, FM_VERSION, n, sampleRate};
+        int32_t rootId = root;
+        uint32_t nodeCount = nodes.size(), sampleCount = samples.size();
+        out.write((const char*)header, sizeof(header));
+        out.write((const char*)&rootId, sizeof(rootId));
+        out.write((const char*)C.data(), C.size() * sizeof(uint32_t));
+        out.write((const char*)code.data(), code.size() * sizeof(uint64_t));
+        out.write((const char*)codeLen.data(), codeLen.size());
+        out.write((const char*)&nodeCount, sizeof(nodeCount));
+        for(const Node &node : nodes) {
+            out.write((const char*)node.child, sizeof(node.child));
+            writeBits(out, node.bits);
         }
+        writeBits(out, sampled);
+        out.write((const char*)&sampleCount, sizeof(sampleCount));
+        out.write((const char*)samples.data(), samples.size() * sizeof(uint32_t));
+        return (bool)out;
     }
     
-    return s1.substr(endIndex - maxLen + 1, maxLen);
+    bool load(const string &path) {
+        ifstream in(path, ios::binary | ios::ate);
+        if(!in) return false;
+        uint64_t fileBytes = in.tellg();
+        in.seekg(0);
+        auto read = [&](void *dst, size_t bytes) { return (bool)in.read((char*)dst, bytes); };
+        
+        FMIndex fm;
+        uint32_t header[4];
+        if(!read(header, sizeof(header)) || header[0] != FM_MAGIC || header[1] != FM_VERSION) return false;
+        fm.n = header[2];
+        fm.sampleRate = header[3];
+        // locate() returns int positions, and every index has at least one sample
+        if(fm.n > (uint32_t)INT_MAX || fm.sampleRate == 0) return false;
+        
+        int32_t rootId;
+        uint32_t nodeCount, sampleCount;
+        fm.C.resize(FM_SYMBOLS + 1);
+        fm.code.resize(FM_SYMBOLS);
+        fm.codeLen.resize(FM_SYMBOLS);
+        if(!read(&rootId, sizeof(rootId)) ||
+           !read(fm.C.data(), fm.C.size() * sizeof(uint32_t)) ||
+           !read(fm.code.data(), fm.code.size() * sizeof(uint64_t)) ||
+           !read(fm.codeLen.data(), fm.codeLen.size()) ||
+           !read(&nodeCount, sizeof(nodeCount))) return false;
+        fm.root = rootId;
+        
+        // A Huffman tree over 257 symbols has at most 256 internal nodes,
+        // and the root is a node or, for an empty text, the '$' leaf
+        if(nodeCount > FM_SYMBOLS - 1) return false;
+        if(rootId >= (int32_t)nodeCount || rootId < -FM_SYMBOLS) return false;
+        
+        // C: non-decreasing, exactly one '$' row, n + 1 rows in total
+        if(fm.C[0] != 0 || fm.C[1] != 1 || fm.C[FM_SYMBOLS] != fm.n + 1) return false;
+        for(int c = 0; c < FM_SYMBOLS; c++) {
+            if(fm.C[c] > fm.C[c + 1] || fm.codeLen[c] > 64) return false;
+        }
+        
+        fm.nodes.assign(nodeCount, Node());
+        for(Node &node : fm.nodes) {
+            if(!read(node.child, sizeof(node.child))) return false;
+            for(int child : node.child) {
+                if(child >= (int)nodeCount || child < -FM_SYMBOLS) return false;
+            }
+            if(!readBits(in, node.bits, fileBytes)) return false;
+        }
+        if(!fm.validTree()) return false;
+        
+        if(!readBits(in, fm.sampled, fileBytes) || fm.sampled.n != (uint64_t)fm.n + 1) return false;
+        if(!read(&sampleCount, sizeof(sampleCount))) return false;
+        if(sampleCount != fm.sampled.rank1(fm.n + 1) ||
+           (uint64_t)sampleCount * sizeof(uint32_t) > fileBytes - (uint64_t)in.tellg()) return false;
+        fm.samples.resize(sampleCount);
+        if(!read(fm.samples.data(), fm.samples.size() * sizeof(uint32_t))) return false;
+        for(uint32_t pos : fm.samples) {
+            if(pos > fm.n) return false;
+        }
+        
+        *this = move(fm);
+        return true;
+    }
+};
+
+// Query latency: FM-index count/locate vs KMPSearch rescanning the text.
+// Text is log-like: random words from a small vocabulary.
+void benchmarkFMIndex(int n) {
+    mt19937 rng(5);
+    vector<string> words = {"GET", "POST", "/api/v1/users", "/login", "200", "404",
+                            "500", "user=", "session", "timeout", "ok", "error"};
+    string text;
+    while((int)text.size() < n) {
+        text += words[rng() % words.size()];
+        text += rng() % 8 ? ' ' : '\n';
+    }
+    text.resize(n);
+    
+    auto elapsed = [](chrono::steady_clock::time_point start) {
+        return chrono::duration<double, micro>(chrono::steady_clock::now() - start).count();
+    };
+    
+    auto start = chrono::steady_clock::now();
+    FMIndex fm(text);
+    double buildMs = elapsed(start) / 1000;
+    
+    vector<string> queries;
+    for(int q = 0; q < 20; q++) queries.push_back(text.substr(rng() % (n - 24), 24));
+    
+    size_t counted = 0, fmHits = 0, kmpHits = 0;
+    start = chrono::steady_clock::now();
+    for(const string &p : queries) counted += fm.count(p);
+    double countUs = elapsed(start) / queries.size();
+    
+    start = chrono::steady_clock::now();
+    for(const string &p : queries) fmHits += fm.locate(p).size();
+    double locateUs = elapsed(start) / queries.size();
+    
+    start = chrono::steady_clock::now();
+    for(const string &p : queries) kmpHits += KMPSearch(text, p).size();
+    double kmpUs = elapsed(start) / queries.size();
+    
+    cout << "FM-index over " << n << " bytes: built in " << buildMs << " ms, "
+         << fm.memoryBytes() << " bytes; per query: count " << countUs << " us, locate "
+         << locateUs << " us (" << fmHits / queries.size() << " hits), KMPSearch " << kmpUs
+         << " us" << (counted == kmpHits && fmHits == kmpHits ? "" : " (MISMATCH)") << endl;
+}
+
+// ===== 12. AHO-CORASICK (MULTI-PATTERN MATCHING) =====
+// All occurrences of many patterns in one pass: O(n + total pattern length
+// + matches), instead of one KMPSearch pass per pattern.
+// Layout:
+//   - bytes are mapped to classes; class 0 = byte in no pattern (-> root)
+//   - dense goto table with failure links folded in; entries are row offsets
+//     (state * width), so a step is one load: s = delta[s + class]
+//   - states that report matches are numbered last, so "anything to report?"
+//     is s >= emitStart with no extra lookup
+//   - outputs in CSR form (outBegin / outIds) plus a dictionary link to the
+//     nearest suffix state that also ends a pattern
+// At the root, an optional prefilter skips bytes that start no pattern
+// (AVX2 nibble lookup, 32 bytes per step; scalar table otherwise).
+
+#if defined(__x86_64__) || defined(__i386__)
+// First i in [from, n) with p[i] in the set described by the nibble tables
+// (byte b = hi:lo is in the set iff bit (hi & 7) of lo{Low,High}[lo] is set)
+__attribute__((target("avx2")))
+size_t nextInSetAVX2(const uint8_t *p, size_t from, size_t n,
+                     const uint8_t *loLow, const uint8_t *loHigh) {
+    const __m256i tabLow = _mm256_broadcastsi128_si256(_mm_loadu_si128((const __m128i*)loLow));
+    const __m256i tabHigh = _mm256_broadcastsi128_si256(_mm_loadu_si128((const __m128i*)loHigh));
+    const __m256i bitOf = _mm256_setr_epi8(1, 2, 4, 8, 16, 32, 64, -128, 1, 2, 4, 8, 16, 32, 64, -128,
+                                           1, 2, 4, 8, 16, 32, 64, -128, 1, 2, 4, 8, 16, 32, 64, -128);
+    const __m256i nibble = _mm256_set1_epi8(0x0F);
+    size_t i = from;
+    for(; i + 32 <= n; i += 32) {
+        __m256i v = _mm256_loadu_si256((const __m256i*)(p + i));
+        __m256i lo = _mm256_and_si256(v, nibble);
+        __m256i hi = _mm256_and_si256(_mm256_srli_epi16(v, 4), nibble);
+        // Top bit of v selects the table for high nibbles 8..15
+        __m256i row = _mm256_blendv_epi8(_mm256_shuffle_epi8(tabLow, lo),
+                                         _mm256_shuffle_epi8(tabHigh, lo), v);
+        __m256i hit = _mm256_and_si256(row, _mm256_shuffle_epi8(bitOf, hi));
+        uint32_t mask = ~_mm256_movemask_epi8(_mm256_cmpeq_epi8(hit, _mm256_setzero_si256()));
+        if(mask) return i + __builtin_ctz(mask);
+    }
+    return i;
+}
+
+bool cpuHasAVX2() {
+    static const bool has = __builtin_cpu_supports("avx2");
+    return has;
+}
+#endif
+
+class AhoCorasick {
+    int width = 1;                    // Byte classes incl. class 0
+    uint8_t cls[256] = {};
+    vector<int> delta;                // Row offset of the next state
+    int emitStart = 0;                // Row offset of the first reporting state
+    vector<int> outBegin, outIds;     // Patterns ending exactly at a state
+    vector<int> dictLink;             // Next suffix state with outputs, -1 if none
+    vector<int> lengths;
+    
+    bool prefilter = false;
+    bool isFirst[256] = {};
+    uint8_t loLow[16] = {}, loHigh[16] = {};
+    
+    int state = 0;                    // Streaming position (row offset)
+    long long offset = 0;
+    
+    // Next position >= i where a pattern could start
+    size_t skipToCandidate(const uint8_t *p, size_t i, size_t n) const {
+#if defined(__x86_64__) || defined(__i386__)
+        if(i < n && !isFirst[p[i]] && cpuHasAVX2()) i = nextInSetAVX2(p, i, n, loLow, loHigh);
+#endif
+        while(i < n && !isFirst[p[i]]) i++;
+        return i;
+    }
+    
+public:
+    // Empty patterns are ignored. With usePrefilter, the root skip is turned
+    // on only when at most 16 distinct bytes start a pattern - otherwise
+    // nearly every byte is a candidate and the check costs more than it saves.
+    AhoCorasick(const vector<string> &patterns, bool usePrefilter = true) {
+        for(const string &p : patterns) {
+            for(unsigned char c : p) {
+                if(!cls[c]) cls[c] = width++;
+            }
+        }
+        
+        // Trie, with -1 for missing edges
+        delta.assign(width, -1);
+        vector<vector<int>> ends(1);
+        int states = 1;
+        for(size_t id = 0; id < patterns.size(); id++) {
+            lengths.push_back(patterns[id].size());
+            if(patterns[id].empty()) continue;
+            isFirst[(unsigned char)patterns[id][0]] = true;
+            int s = 0;
+            for(unsigned char c : patterns[id]) {
+                int &next = delta[(size_t)s * width + cls[c]];
+                if(next == -1) {
+                    next = states++;
+                    delta.resize((size_t)states * width, -1);
+                    ends.emplace_back();
+                }
+                s = delta[(size_t)s * width + cls[c]];
+            }
+            ends[s].push_back(id);
+        }
+        
+        // BFS: fill missing edges from the failure state, set dict links
+        vector<int> fail(states, 0), order = {0};
+        dictLink.assign(states, -1);
+        delta[0] = 0;
+        for(int c = 1; c < width; c++) {
+            int &t = delta[c];
+            if(t == -1) t = 0;
+            else order.push_back(t);
+        }
+        for(size_t k = 1; k < order.size(); k++) {
+            int s = order[k];
+            int f = fail[s];
+            dictLink[s] = ends[f].empty() ? dictLink[f] : f;
+            delta[(size_t)s * width] = 0;
+            for(int c = 1; c < width; c++) {
+                int &t = delta[(size_t)s * width + c];
+                if(t == -1) {
+                    t = delta[(size_t)f * width + c];
+                } else {
+                    fail[t] = delta[(size_t)f * width + c];
+                    order.push_back(t);
+                }
+            }
+        }
+        
+        // Renumber: silent states first (root stays 0), reporting states last
+        vector<int> newId(states), oldId;
+        for(int pass = 0; pass < 2; pass++) {
+            if(pass == 1) emitStart = oldId.size() * width;
+            for(int s = 0; s < states; s++) {
+                bool emits = !ends[s].empty() || dictLink[s] != -1;
+                if(emits == (pass == 1)) {
+                    newId[s] = oldId.size();
+                    oldId.push_back(s);
+                }
+            }
+        }
+        
+        vector<int> table((size_t)states * width), links(states, -1);
+        outBegin.assign(states + 1, 0);
+        for(int t = 0; t < states; t++) {
+            int s = oldId[t];
+            for(int c = 0; c < width; c++) {
+                table[(size_t)t * width + c] = newId[delta[(size_t)s * width + c]] * width;
+            }
+            if(dictLink[s] != -1) links[t] = newId[dictLink[s]];
+            outBegin[t + 1] = outBegin[t] + ends[s].size();
+            outIds.insert(outIds.end(), ends[s].begin(), ends[s].end());
+        }
+        delta.swap(table);
+        dictLink.swap(links);
+        
+        int firstCount = 0;
+        for(int b = 0; b < 256; b++) {
+            if(!isFirst[b]) continue;
+            firstCount++;
+            (b < 128 ? loLow : loHigh)[b & 15] |= 1 << (b >> 4 & 7);
+        }
+        prefilter = usePrefilter && firstCount <= 16;
+    }
+    
+    // Start a new stream
+    void reset() {
+        state = 0;
+        offset = 0;
+    }
+    
+    // Streaming: feed the text chunk by chunk; matches may span chunks.
+    // onMatch(patternId, startOffset) with offsets counted from the stream start.
+    template<class F>
+    void feed(string_view chunk, F &&onMatch) {
+        const uint8_t *p = (const uint8_t*)chunk.data();
+        size_t n = chunk.size();
+        int s = state;
+        for(size_t i = 0; i < n; i++) {
+            if(s == 0 && prefilter) {
+                i = skipToCandidate(p, i, n);
+                if(i == n) break;
+            }
+            s = delta[s + cls[p[i]]];
+            if(s < emitStart) continue;
+            long long end = offset + i + 1;
+            for(int t = s / width; t != -1; t = dictLink[t]) {
+                for(int k = outBegin[t]; k < outBegin[t + 1]; k++) {
+                    onMatch(outIds[k], end - lengths[outIds[k]]);
+                }
+            }
+        }
+        state = s;
+        offset += n;
+    }
+    
+    // Whole text at once: {patternId, start} in order of match end
+    vector<pair<int, long long>> findAll(string_view text) {
+        vector<pair<int, long long>> matches;
+        reset();
+        feed(text, [&](int id, long long start) { matches.push_back({id, start}); });
+        reset();
+        return matches;
+    }
+    
+    size_t memoryBytes() const {
+        return (delta.size() + outBegin.size() + outIds.size() + dictLink.size() + lengths.size()) * 4;
+    }
+};
+
+// Throughput on log-like text: Aho-Corasick vs one KMPSearch per pattern,
+// and the root prefilter on rare-first-byte patterns
+void benchmarkAhoCorasick(int n) {
+    mt19937 rng(9);
+    auto randomWord = [&](int len) {
+        string w(len, 'a');
+        for(char &c : w) c = 'a' + rng() % 26;
+        return w;
+    };
+    string text;
+    while((int)text.size() < n) {
+        text += rng() % 64 ? randomWord(3 + rng() % 6) : "ERROR";
+        text += ' ';
+    }
+    text.resize(n);
+    
+    auto gbPerSec = [&](auto &&body) {
+        auto start = chrono::steady_clock::now();
+        body();
+        double sec = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+        return text.size() / sec / 1e9;
+    };
+    
+    vector<string> few, many, rare;
+    for(int i = 0; i < 100; i++) few.push_back(randomWord(5));
+    for(int i = 0; i < 50000; i++) many.push_back(randomWord(4 + rng() % 8));
+    for(int i = 0; i < 100; i++) rare.push_back("ERROR " + randomWord(2) + (i % 2 ? "X" : "#"));
+    
+    size_t kmpHits = 0, acHits = 0;
+    double kmp = gbPerSec([&]() {
+        for(const string &p : few) kmpHits += KMPSearch(text, p).size();
+    });
+    AhoCorasick acFew(few), acMany(many), acRare(rare), acRarePlain(rare, false);
+    double tFew = gbPerSec([&]() { acHits = acFew.findAll(text).size(); });
+    double tMany = gbPerSec([&]() { acMany.findAll(text); });
+    double tRare = gbPerSec([&]() { acRare.findAll(text); });
+    double tRarePlain = gbPerSec([&]() { acRarePlain.findAll(text); });
+    
+    cout << "Aho-Corasick over " << n << " bytes (GB/s): 100 patterns " << tFew
+         << " vs 100 x KMPSearch " << kmp << (acHits == kmpHits ? "" : " (MISMATCH)")
+         << "; 50000 patterns " << tMany << " (" << acMany.memoryBytes() / (1 << 20)
+         << " MB); rare first byte " << tRare << " with prefilter, " << tRarePlain
+         << " without" << endl;
+}
+
+// ===== 13. SIMD SUBSTRING SEARCH =====
+// Single-pattern fast path ("generic SIMD" first/last byte filter):
+// compare 32 text bytes against pattern[0] and, m - 1 bytes further on,
+// against pattern[m - 1]; only positions where both agree are checked
+// with memcmp. On typical text that is ~1 candidate per few KB.
+// AVX2 is picked at runtime; the scalar path uses memchr on the first byte.
+
+#if defined(__x86_64__) || defined(__i386__)
+// Starts in [0, limit) with limit = n - m + 1, 32 at a time; returns where it stopped
+template<class F>
+__attribute__((target("avx2")))
+size_t findAllAVX2(const char *s, size_t limit, const char *p, size_t m, F &onMatch) {
+    const __m256i first = _mm256_set1_epi8(p[0]);
+    const __m256i last = _mm256_set1_epi8(p[m - 1]);
+    size_t middle = m > 2 ? m - 2 : 0;
+    size_t i = 0;
+    for(; i + 32 <= limit; i += 32) {
+        __m256i blockFirst = _mm256_loadu_si256((const __m256i*)(s + i));
+        __m256i blockLast = _mm256_loadu_si256((const __m256i*)(s + i + m - 1));
+        uint32_t mask = _mm256_movemask_epi8(_mm256_and_si256(_mm256_cmpeq_epi8(first, blockFirst),
+                                                              _mm256_cmpeq_epi8(last, blockLast)));
+        while(mask) {
+            size_t pos = i + __builtin_ctz(mask);
+            if(memcmp(s + pos + 1, p + 1, middle) == 0) onMatch(pos);
+            mask &= mask - 1;
+        }
+    }
+    return i;
+}
+#endif
+
+// All occurrences of pattern in text, in order (empty pattern: none)
+vector<int> findAll(string_view text, string_view pattern) {
+    vector<int> result;
+    size_t n = text.size(), m = pattern.size();
+    if(m == 0 || m > n) return result;
+    
+    const char *s = text.data(), *p = pattern.data();
+    auto onMatch = [&](size_t pos) { result.push_back(pos); };
+    size_t last = n - m;  // Last possible start
+    size_t i = 0;
+    
+#if defined(__x86_64__) || defined(__i386__)
+    if(cpuHasAVX2() && last + 1 >= 32) {
+        i = findAllAVX2(s, last + 1, p, m, onMatch);
+    }
+#endif
+    
+    // Scalar: memchr to the next first-byte hit, then last byte, then the rest
+    while(i <= last) {
+        const char *hit = (const char*)memchr(s + i, p[0], last - i + 1);
+        if(!hit) break;
+        i = hit - s;
+        if(s[i + m - 1] == p[m - 1] && memcmp(s + i, p, m) == 0) onMatch(i);
+        i++;
+    }
+    return result;
+}
+
+// findAll vs KMPSearch / ZSearch / rabinKarp / repeated string::find
+void benchmarkSubstringSearch(int n) {
+    mt19937 rng(13);
+    string text(n, ' ');
+    for(char &c : text) c = rng() % 6 ? 'a' + rng() % 26 : ' ';
+    
+    auto time = [](auto &&body) {
+        auto start = chrono::steady_clock::now();
+        body();
+        return chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+    };
+    
+    for(int m : {4, 16, 64}) {
+        string pattern = text.substr(n / 2, m);
+        vector<int> simd, kmp, z, rk, stl;
+        double tSimd = time([&]() { simd = findAll(text, pattern); });
+        double tKmp = time([&]() { kmp = KMPSearch(text, pattern); });
+        double tZ = time([&]() { z = ZSearch(text, pattern); });
+        double tRk = time([&]() { rk = rabinKarp(text, pattern); });
+        double tStl = time([&]() {
+            for(size_t pos = text.find(pattern); pos != string::npos; pos = text.find(pattern, pos + 1)) {
+                stl.push_back(pos);
+            }
+        });
+        bool same = simd == kmp && simd == z && simd == rk && simd == stl;
+        
+        cout << "Search m = " << m << " in " << n << " bytes (ms): findAll " << tSimd
+             << ", KMP " << tKmp << ", Z " << tZ << ", Rabin-Karp " << tRk
+             << ", string::find " << tStl << (same ? "" : " (MISMATCH)") << endl;
+    }
 }
 
 // ===== MAIN FUNCTION =====
@@ -390,16 +2187,114 @@ int main() {
     for(int pos : kmpResult) cout << pos << " ";
     cout << endl;
     
+    // Same search with the text streamed in 4-byte chunks
+    KMPMatcher kmpStream(pattern);
+    ZMatcher zStream(pattern);
+    istringstream kmpIn(text), zIn(text);
+    cout << "Streaming KMP / Z occurrences: ";
+    auto print = [](long long pos) { cout << pos << " "; };
+    scanStream(kmpIn, kmpStream, print, 4);
+    cout << "/ ";
+    scanStream(zIn, zStream, print, 4);
+    cout << endl;
+    
+    // SIMD first/last-byte search
+    vector<int> simdResult = findAll(text, pattern);
+    cout << "findAll occurrences: ";
+    for(int pos : simdResult) cout << pos << " ";
+    cout << endl;
+    
     // Rabin-Karp
     vector<int> rkResult = rabinKarp(text, pattern);
     cout << "Rabin-Karp occurrences: ";
     for(int pos : rkResult) cout << pos << " ";
     cout << endl;
     
+    // O(1) substring hashes mod 2^61 - 1
+    PrefixHash ph(text);
+    cout << "text[0..4) == text[10..14)? " << substringsEqual(ph, 0, ph, 10, 4)
+         << ", LCP(text[0..], text[10..]) = " << lcp(ph, 0, ph, 10) << endl;
+    cout << "Longest common substring of 'xabcdey' and 'zzbcdex': "
+         << longestCommonSubstringHashed("xabcdey", "zzbcdex") << endl;
+    
+    // Suffix automaton
+    SuffixAutomaton sam("banana");
+    cout << "Distinct substrings of 'banana': " << sam.countDistinct()
+         << ", 5th smallest: " << sam.kthSubstring(5) << endl;
+    cout << "Longest common substring of 'xabcdey', 'zzbcdex', 'bcdq': "
+         << longestCommonSubstring(vector<string>{"xabcdey", "zzbcdex", "bcdq"}) << endl;
+    
     // Longest Palindromic Substring
     string palindrome = "babad";
     cout << "\nLongest palindromic substring of '" << palindrome << "': ";
     cout << longestPalindromicSubstring(palindrome) << endl;
+    Manacher radii(palindrome);
+    Eertree tree;
+    for(char c : palindrome) tree.add(c);
+    cout << "Is 'aba' (s[1..4)) a palindrome? " << radii.isPalindrome(1, 4)
+         << ", distinct palindromes: " << tree.countDistinct()
+         << ", fewest palindromic pieces: " << minPalindromePartition(palindrome) << endl;
+    
+    // Suffix array (SA-IS) and LCP
+    string banana = "banana";
+    vector<int> sa = buildSuffixArray(banana);
+    vector<int> lcp = buildLCP(banana, sa);
+    cout << "\nSuffix array of 'banana': ";
+    for(int i : sa) cout << i << " ";
+    cout << "\nLCP: ";
+    for(int x : lcp) cout << x << " ";
+    cout << "\nLongest repeating substring: " << longestRepeatingSubstring(banana) << endl;
+    benchmarkSuffixArray(1 << 22);
+    
+    // FM-index: count / locate, saved to disk and loaded back
+    FMIndex fm(text);
+    fm.save("fm_index.bin");
+    FMIndex loaded;
+    loaded.load("fm_index.bin");
+    cout << "\nFM-index: 'AB' occurs " << loaded.count("AB") << " times at: ";
+    for(int pos : loaded.locate("AB")) cout << pos << " ";
+    cout << "\nEmpty pattern count: " << loaded.count("") << endl;
+    ofstream("fm_index.bin", ios::binary) << "not an index";
+    cout << "Loading a corrupt file: " << (loaded.load("fm_index.bin") ? "accepted" : "rejected")
+         << ", index still answers 'AB': " << loaded.count("AB") << endl;
+    remove("fm_index.bin");
+    benchmarkFMIndex(1 << 24);
+    
+    // Aho-Corasick: many patterns in one pass, text fed in two chunks
+    AhoCorasick ac({"he", "she", "his", "hers"});
+    cout << "\nAho-Corasick matches in 'ushers': ";
+    auto report = [](int id, long long start) { cout << "(" << id << " at " << start << ") "; };
+    ac.feed("ush", report);
+    ac.feed("ers", report);
+    cout << endl;
+    benchmarkAhoCorasick(1 << 24);
+    benchmarkSubstringSearch(1 << 24);
+    
+    // Anagram groups as index lists
+    vector<string> words = {"eat", "tea", "tan", "ate", "nat", "bat"};
+    AnagramGroups anagrams = groupAnagramIndices(words);
+    cout << "\nAnagram groups:";
+    for(size_t g = 0; g < anagrams.size(); g++) {
+        cout << " [";
+        for(uint32_t k = anagrams.start[g]; k < anagrams.start[g + 1]; k++) {
+            cout << (k > anagrams.start[g] ? " " : "") << words[anagrams.members[k]];
+        }
+        cout << "]";
+    }
+    cout << endl;
+    benchmarkAnagramGrouping(1 << 22);
+    
+    // Lyndon factorization and canonical rotations
+    cout << "\nLyndon factors of 'banana': ";
+    vector<size_t> factors = lyndonFactorization(banana);
+    for(size_t k = 0; k < factors.size(); k++) {
+        size_t end = k + 1 < factors.size() ? factors[k + 1] : banana.size();
+        cout << banana.substr(factors[k], end - factors[k]) << " ";
+    }
+    cout << "\nMin rotation of 'banana' starts at " << minRotation(banana)
+         << "; same fingerprint for 'nanaba'? "
+         << (rotationFingerprint("banana") == rotationFingerprint("nanaba")) << endl;
+    benchmarkRotations(1 << 20);
     
     return 0;
 }
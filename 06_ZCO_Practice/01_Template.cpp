@@ -52,24 +52,107 @@ ll lcm(ll a, ll b) {
 }
 
 // Modular arithmetic
+// ModInt<M>: arithmetic mod a compile-time odd M < 2^31 in Montgomery form
+// (x * 2^32 mod M), so a multiply is two integer multiplies and a shift.
+// Full version with runtime-modulus and batch variants: 05_Advanced/01_Number_Theory.cpp
+template<uint32_t M>
+struct ModInt {
+    static_assert(M % 2 == 1 && M < (1u << 31), "Montgomery needs an odd modulus < 2^31");
+    
+    static constexpr uint32_t computeNegInv() {
+        uint32_t inv = M;
+        for(int i = 0; i < 4; i++) inv *= 2 - M * inv;
+        return -inv;
+    }
+    static constexpr uint32_t NEG_INV = computeNegInv();         // -M^-1 mod 2^32
+    static constexpr uint32_t R2 = (uint32_t)(-(uint64_t)M % M);  // 2^64 mod M
+    
+    static uint32_t reduce(uint64_t x) {
+        uint32_t q = (uint32_t)x * NEG_INV;
+        uint32_t r = (x + (uint64_t)q * M) >> 32;
+        return r >= M ? r - M : r;
+    }
+    
+    uint32_t v;
+    
+    ModInt() : v(0) {}
+    ModInt(long long x) {
+        x %= (long long)M;
+        if(x < 0) x += M;
+        v = reduce((uint64_t)x * R2);
+    }
+    
+    uint32_t val() const { return reduce(v); }
+    
+    ModInt& operator+=(const ModInt &o) { v += o.v; if(v >= M) v -= M; return *this; }
+    ModInt& operator-=(const ModInt &o) { v = v >= o.v ? v - o.v : v + M - o.v; return *this; }
+    ModInt& operator*=(const ModInt &o) { v = reduce((uint64_t)v * o.v); return *this; }
+    ModInt& operator/=(const ModInt &o) { return *this *= o.inv(); }
+    
+    friend ModInt operator+(ModInt a, const ModInt &b) { return a += b; }
+    friend ModInt operator-(ModInt a, const ModInt &b) { return a -= b; }
+    friend ModInt operator*(ModInt a, const ModInt &b) { return a *= b; }
+    friend ModInt operator/(ModInt a, const ModInt &b) { return a /= b; }
+    bool operator==(const ModInt &o) const { return v == o.v; }
+    bool operator!=(const ModInt &o) const { return v != o.v; }
+    
+    ModInt pow(long long exp) const {
+        ModInt result = 1, base = *this;
+        while(exp > 0) {
+            if(exp & 1) result *= base;
+            base *= base;
+            exp >>= 1;
+        }
+        return result;
+    }
+    
+    ModInt inv() const { return pow(M - 2); }  // M must be prime
+};
+
+typedef ModInt<MOD> mint;
+
+// Plain helpers: the default modulus uses % by a compile-time constant
+// (compiled to a multiply), others use 128-bit products. One-off operations
+// don't pay for Montgomery conversions; modPow stays in mint for its loop.
 ll modAdd(ll a, ll b, ll mod = MOD) {
-    return ((a % mod) + (b % mod)) % mod;
+    if(mod == MOD) {
+        if((unsigned long long)a < MOD && (unsigned long long)b < MOD) {
+            ll r = a + b;
+            return r >= MOD ? r - MOD : r;
+        }
+        ll r = (a % MOD + b % MOD) % MOD;
+        return r < 0 ? r + MOD : r;
+    }
+    return ((a % mod + b % mod) % mod + mod) % mod;
 }
 
 ll modSub(ll a, ll b, ll mod = MOD) {
-    return ((a % mod) - (b % mod) + mod) % mod;
+    if(mod == MOD) {
+        if((unsigned long long)a < MOD && (unsigned long long)b < MOD) {
+            ll r = a - b;
+            return r < 0 ? r + MOD : r;
+        }
+        ll r = (a % MOD - b % MOD) % MOD;
+        return r < 0 ? r + MOD : r;
+    }
+    return ((a % mod - b % mod) % mod + mod) % mod;
 }
 
 ll modMul(ll a, ll b, ll mod = MOD) {
-    return ((a % mod) * (b % mod)) % mod;
+    if(mod == MOD) {
+        ll r = (a % MOD) * (b % MOD) % MOD;  // |product| < MOD^2 < 2^60
+        return r < 0 ? r + MOD : r;
+    }
+    return ((__int128)(a % mod) * (b % mod) % mod + mod) % mod;
 }
 
 ll modPow(ll base, ll exp, ll mod = MOD) {
-    ll result = 1;
-    base %= mod;
+    if(mod == MOD) return mint(base).pow(exp).val();
+    ll result = 1 % mod;
+    base = (base % mod + mod) % mod;
     while(exp > 0) {
-        if(exp & 1) result = (result * base) % mod;
-        base = (base * base) % mod;
+        if(exp & 1) result = (__int128)result * base % mod;
+        base = (__int128)base * base % mod;
         exp >>= 1;
     }
     return result;
@@ -252,18 +252,58 @@ int lengthOfLongestSubstring(string s) {
 }
 
 // ===== PROBLEM 14: GROUP ANAGRAMS =====
+// Key = 64-bit hash of the character histogram: a random value per byte,
+// summed, so it is O(len) with no sort and no key string per input.
+// Equal hashes are confirmed by comparing counts against the group's first
+// member. Groups are kept as index lists; strings are copied once, at the end.
+// Arena / parallel version: 05_Advanced/02_String_Algorithms.cpp
 vector<vector<string>> groupAnagrams(vector<string>& strs) {
-    unordered_map<string, vector<string>> groups;
-    
-    for(string& s : strs) {
-        string key = s;
-        sort(key.begin(), key.end());
-        groups[key].push_back(s);
+    static const vector<uint64_t> charValue = [] {
+        mt19937_64 rng(0x5EED);
+        vector<uint64_t> v(256);
+        for(uint64_t &x : v) x = rng();
+        return v;
+    }();
+    
+    unordered_map<uint64_t, int> firstGroup;  // Hash -> first group with it
+    vector<int> nextGroup;                    // Next group with the same hash (-1 = none)
+    vector<vector<int>> groups;
+    int count[256] = {};                      // Scratch, left zeroed
+    
+    auto sameHistogram = [&](const string &a, const string &b) {
+        if(a.size() != b.size()) return false;
+        for(unsigned char c : a) count[c]++;
+        for(unsigned char c : b) count[c]--;
+        bool same = true;
+        for(unsigned char c : a) same &= count[c] == 0;
+        for(unsigned char c : a) count[c] = 0;
+        for(unsigned char c : b) count[c] = 0;
+        return same;
+    };
+    
+    for(size_t i = 0; i < strs.size(); i++) {
+        uint64_t h = strs[i].size() * 0x9E3779B97F4A7C15ULL;
+        for(unsigned char c : strs[i]) h += charValue[c];
+        
+        auto it = firstGroup.find(h);
+        int g = it == firstGroup.end() ? -1 : it->second;
+        while(g != -1 && !sameHistogram(strs[groups[g][0]], strs[i])) g = nextGroup[g];
+        
+        if(g == -1) {
+            g = groups.size();
+            groups.emplace_back();
+            // New group goes to the front of this hash's chain
+            nextGroup.push_back(it == firstGroup.end() ? -1 : it->second);
+            firstGroup[h] = g;
+        }
+        groups[g].push_back(i);
     }
     
-    vector<vector<string>> result;
-    for(auto& pair : groups) {
-        result.push_back(pair.second);
+    vector<vector<string>> result(groups.size());
+    for(size_t g = 0; g < groups.size(); g++) {
+        for(int i : groups[g]) {
+            result[g].push_back(strs[i]);
+        }
     }
     
     return result;